@@ -0,0 +1,507 @@
+/*
+ * aes_file.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Command line tool to encrypt or decrypt large files with
+ * AES-XTS or AES-GCM. Regular files are memory mapped on both
+ * sides; other inputs, or -s, go through a read/encrypt/write
+ * pipeline of large aligned buffers on separate threads, or for
+ * GCM through one buffer and a GcmStream.
+ */
+
+#include "lib/gcm.h"
+#include "lib/xts.h"
+#include "lib/parallel.h"
+#include "lib/byte_order.h"
+#include "lib/byte_span.h"
+#include "lib/table_file.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::cerr;
+
+// Bytes handed to each pipeline stage or processed per mapped step
+const size_t CHUNK_SIZE = 16 << 20;
+// Buffers in flight in the pipeline: one reading, one held back, one encrypting, one writing
+const int PIPELINE_BUFFERS = 4;
+// GCM file layout is nonce, ciphertext, tag
+const size_t GCM_IV_SIZE = 12;
+const size_t GCM_TAG_SIZE = 16;
+
+/*
+ * Options
+ * Everything read from the command line.
+ */
+struct Options{
+    bool decrypting = false;
+    bool streaming = false;
+    string mode = "xts";
+    AesEngine engine = ENGINE_AUTO;
+    int threads = 0;
+    size_t sectorSize = 4096;
+    string tableFile;
+    vector<unsigned char> key;
+    string input;
+    string output;
+};
+
+// Prints how to call the tool and exits
+void usage(){
+    cerr << "usage: aes_file [-d] [-m xts|gcm] [-e auto|table|hardware] [-t threads]\n"
+         << "                [-b sector_size] [-s] [-T table_file] -k hex_key input output\n"
+         << "  -d  decrypt instead of encrypt\n"
+         << "  -m  mode, xts takes two keys of 16, 24 or 32 bytes back to back (default xts)\n"
+         << "  -s  stream through buffers even when the files could be mapped\n"
+         << "  -T  map the lookup tables from a table file, writing it first if it does not exist\n";
+    std::exit(2);
+}
+
+// Reads the command line
+Options parseOptions(int argc, char ** argv){
+    Options o;
+    vector<string> positional;
+    for(int i=1; i<argc; i++){
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(arg == "-d") o.decrypting = true;
+        else if(arg == "-s") o.streaming = true;
+        else if(arg == "-m" && hasValue) o.mode = argv[++i];
+        else if(arg == "-k" && hasValue) o.key = fromHex(argv[++i]);
+        else if(arg == "-t" && hasValue) o.threads = std::atoi(argv[++i]);
+        else if(arg == "-T" && hasValue) o.tableFile = argv[++i];
+        else if(arg == "-b" && hasValue) o.sectorSize = std::strtoul(argv[++i], nullptr, 10);
+        else if(arg == "-e" && hasValue){
+            string engine = argv[++i];
+            if(engine == "auto") o.engine = ENGINE_AUTO;
+            else if(engine == "table") o.engine = ENGINE_TABLE;
+            else if(engine == "hardware") o.engine = ENGINE_HARDWARE;
+            else usage();
+        }
+        else if(arg.size() > 1 && arg[0] == '-') usage();
+        else positional.push_back(arg);
+    }
+    if(positional.size() != 2 || o.key.empty()) usage();
+    if(o.mode != "xts" && o.mode != "gcm") usage();
+    if(o.sectorSize < 16 || o.sectorSize > CHUNK_SIZE/2 || CHUNK_SIZE % o.sectorSize != 0){
+        throw runtime_error("Sector size must divide 16 MB and be at least 16 bytes.");
+    }
+    o.input = positional[0];
+    o.output = positional[1];
+    return o;
+}
+
+// Builds the XTS context from a double length key
+Xts makeXts(const Options & o){
+    int half = o.key.size() / 2;
+    return Xts(AesKey(o.key.data(), half), AesKey(o.key.data() + half, half), o.engine);
+}
+
+// Runs length bytes of sectors numbered from firstSector. A tail shorter than a
+// block cannot stand alone, so it joins the sector before it as one data unit.
+void cryptSectorRange(const Xts & xts, bool decrypting, const unsigned char * in, unsigned char * out,
+                      size_t length, size_t sectorSize, uint64_t firstSector, int threads){
+    size_t full = length / sectorSize;
+    size_t rest = length % sectorSize;
+    if(rest != 0 && rest < AES_BLOCK_SIZE){
+        if(full == 0) throw runtime_error("XTS needs at least 16 bytes of data.");
+        full--;
+        rest += sectorSize;
+    }
+    
+    if(decrypting) xts.decryptSectors(in, out, sectorSize, full, firstSector, threads);
+    else xts.encryptSectors(in, out, sectorSize, full, firstSector, threads);
+    
+    if(rest != 0){
+        unsigned char tweak[16];
+        storeLittle64(tweak, firstSector + full);
+        storeLittle64(tweak + 8, 0);
+        size_t offset = full*sectorSize;
+        if(decrypting) xts.decryptUnit(tweak, in + offset, out + offset, rest);
+        else xts.encryptUnit(tweak, in + offset, out + offset, rest);
+    }
+}
+
+/*
+ * MappedFile
+ * A whole file mapped into memory, unmapped and closed on
+ * destruction.
+ */
+class MappedFile{
+public:
+    // Maps an existing file for reading, returns false if it cannot be mapped
+    bool openRead(const string & path){
+        _fd = open(path.c_str(), O_RDONLY);
+        if(_fd < 0) throw runtime_error("Cannot open " + path);
+        struct stat st;
+        if(fstat(_fd, &st) != 0 || !S_ISREG(st.st_mode)) return false;
+        _size = st.st_size;
+        if(_size == 0) return true;
+        void * p = mmap(nullptr, _size, PROT_READ, MAP_SHARED, _fd, 0);
+        if(p == MAP_FAILED) return false;
+        _data = (unsigned char *) p;
+        madvise(_data, _size, MADV_SEQUENTIAL);
+        return true;
+    }
+    
+    // Creates or truncates a file of size bytes and maps it for writing
+    void openWrite(const string & path, size_t size){
+        _fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(_fd < 0) throw runtime_error("Cannot create " + path);
+        if(ftruncate(_fd, size) != 0) throw runtime_error("Cannot size " + path);
+        _size = size;
+        if(_size == 0) return;
+        void * p = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if(p == MAP_FAILED) throw runtime_error("Cannot map " + path);
+        _data = (unsigned char *) p;
+    }
+    
+    // Asks the kernel to start reading a range before it is touched
+    void prefetch(size_t offset, size_t length){
+        if(_data == nullptr || offset >= _size) return;
+        size_t page = sysconf(_SC_PAGESIZE);
+        size_t begin = offset / page * page;
+        madvise(_data + begin, std::min(offset + length, _size) - begin, MADV_WILLNEED);
+    }
+    
+    // Starts writing back a finished range without waiting for it
+    void flush(size_t offset, size_t length){
+        if(_data == nullptr) return;
+        size_t page = sysconf(_SC_PAGESIZE);
+        size_t begin = offset / page * page;
+        msync(_data + begin, offset + length - begin, MS_ASYNC);
+    }
+    
+    unsigned char * data(){ return _data; }
+    size_t size() const{ return _size; }
+    int fd() const{ return _fd; }
+    
+    ~MappedFile(){
+        if(_data != nullptr) munmap(_data, _size);
+        if(_fd >= 0) close(_fd);
+    }
+
+private:
+    int _fd = -1;
+    unsigned char * _data = nullptr;
+    size_t _size = 0;
+};
+
+// Encrypts a mapped file a chunk at a time, reading ahead and writing behind the chunk in use
+size_t runMappedXts(const Options & o, MappedFile & in){
+    Xts xts = makeXts(o);
+    MappedFile out;
+    out.openWrite(o.output, in.size());
+    
+    size_t size = in.size();
+    for(size_t offset=0; offset<size; ){
+        size_t length = std::min(CHUNK_SIZE, size - offset);
+        // Keep a short tail with this chunk so it can join the last sector
+        if(size - offset - length < AES_BLOCK_SIZE) length = size - offset;
+        in.prefetch(offset + length, CHUNK_SIZE);
+        cryptSectorRange(xts, o.decrypting, in.data() + offset, out.data() + offset, length,
+                         o.sectorSize, offset / o.sectorSize, o.threads);
+        out.flush(offset, length);
+        offset += length;
+    }
+    return size;
+}
+
+// GCM is one message, so the mapping is handed over whole and the kernel reads ahead
+size_t runMappedGcm(const Options & o, MappedFile & in){
+    Gcm gcm(AesKey(o.key.data(), o.key.size()), GHASH_AUTO, o.engine);
+    MappedFile out;
+    
+    if(!o.decrypting){
+        unsigned char iv[GCM_IV_SIZE];
+        std::random_device random;
+        for(size_t i=0; i<GCM_IV_SIZE; i++) iv[i] = (unsigned char) random();
+        
+        out.openWrite(o.output, GCM_IV_SIZE + in.size() + GCM_TAG_SIZE);
+        std::memcpy(out.data(), iv, GCM_IV_SIZE);
+        gcm.encrypt(iv, GCM_IV_SIZE, nullptr, 0, in.data(), out.data() + GCM_IV_SIZE, in.size(),
+                    out.data() + GCM_IV_SIZE + in.size());
+        return in.size();
+    }
+    
+    if(in.size() < GCM_IV_SIZE + GCM_TAG_SIZE) throw runtime_error("Input is too short for GCM.");
+    size_t length = in.size() - GCM_IV_SIZE - GCM_TAG_SIZE;
+    out.openWrite(o.output, length);
+    if(!gcm.decrypt(in.data(), GCM_IV_SIZE, nullptr, 0, in.data() + GCM_IV_SIZE, out.data(), length,
+                    in.data() + GCM_IV_SIZE + length)){
+        unlink(o.output.c_str());
+        throw runtime_error("Authentication failed, no output written.");
+    }
+    return length;
+}
+
+/*
+ * Chunk
+ * One pipeline buffer and the part of the file it holds.
+ */
+struct Chunk{
+    unsigned char * data;
+    size_t length;
+    uint64_t firstSector;
+};
+
+/*
+ * ChunkQueue
+ * Hands chunks from one pipeline stage to the next. A chunk
+ * with no data marks the end of the stream.
+ */
+class ChunkQueue{
+public:
+    void push(Chunk c){
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _chunks.push_back(c);
+        }
+        _ready.notify_one();
+    }
+    
+    Chunk pop(){
+        std::unique_lock<std::mutex> lock(_mutex);
+        _ready.wait(lock, [this]{ return !_chunks.empty(); });
+        Chunk c = _chunks.front();
+        _chunks.pop_front();
+        return c;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    std::deque<Chunk> _chunks;
+};
+
+// Reads until length bytes arrive or the input ends, returns the bytes read
+size_t readFull(int fd, unsigned char * p, size_t length){
+    size_t done = 0;
+    while(done < length){
+        ssize_t n = read(fd, p + done, length - done);
+        if(n < 0) throw runtime_error("Read failed.");
+        if(n == 0) break;
+        done += n;
+    }
+    return done;
+}
+
+// Writes all length bytes
+void writeFull(int fd, const unsigned char * p, size_t length){
+    while(length > 0){
+        ssize_t n = write(fd, p, length);
+        if(n < 0) throw runtime_error("Write failed.");
+        p += n;
+        length -= n;
+    }
+}
+
+// Streams XTS through a reader thread, the calling thread's workers and a writer thread
+size_t runStreamedXts(const Options & o, int inFd){
+    Xts xts = makeXts(o);
+    int outFd = open(o.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(outFd < 0) throw runtime_error("Cannot create " + o.output);
+    
+    vector<unsigned char *> buffers;
+    ChunkQueue empty, filled, done;
+    for(int i=0; i<PIPELINE_BUFFERS; i++){
+        // Room for a borrowed sector on top of the chunk
+        void * p = nullptr;
+        if(posix_memalign(&p, 4096, CHUNK_SIZE + o.sectorSize) != 0) throw runtime_error("Out of memory.");
+        buffers.push_back((unsigned char *) p);
+        empty.push(Chunk{ (unsigned char *) p, 0, 0 });
+    }
+    
+    // The reader holds one chunk back, so a final piece shorter than a block
+    // can take the last sector of the chunk before it
+    size_t total = 0;
+    std::exception_ptr readError, writeError;
+    std::thread reader([&]{
+        Chunk held = { nullptr, 0, 0 };
+        uint64_t sector = 0;
+        try{
+            while(true){
+                Chunk c = empty.pop();
+                c.length = readFull(inFd, c.data, CHUNK_SIZE);
+                if(c.length == 0){
+                    empty.push(c);
+                    break;
+                }
+                if(held.data != nullptr){
+                    if(c.length < AES_BLOCK_SIZE){
+                        std::memmove(c.data + o.sectorSize, c.data, c.length);
+                        std::memcpy(c.data, held.data + held.length - o.sectorSize, o.sectorSize);
+                        held.length -= o.sectorSize;
+                        c.length += o.sectorSize;
+                    }
+                    held.firstSector = sector;
+                    sector += held.length / o.sectorSize;
+                    filled.push(held);
+                }
+                held = c;
+                if(c.length < CHUNK_SIZE) break;
+            }
+        }
+        catch(...){
+            readError = std::current_exception();
+        }
+        if(held.data != nullptr){
+            held.firstSector = sector;
+            filled.push(held);
+        }
+        filled.push(Chunk{ nullptr, 0, 0 });
+    });
+    
+    std::thread writer([&]{
+        while(true){
+            Chunk c = done.pop();
+            if(c.data == nullptr) break;
+            // After a failed write keep draining so the other stages can finish
+            if(!writeError){
+                try{
+                    writeFull(outFd, c.data, c.length);
+                    total += c.length;
+                }
+                catch(...){
+                    writeError = std::current_exception();
+                }
+            }
+            empty.push(c);
+        }
+    });
+    
+    // Errors are held until both threads have drained
+    std::exception_ptr error;
+    while(true){
+        Chunk c = filled.pop();
+        if(c.data == nullptr) break;
+        if(!error){
+            try{
+                cryptSectorRange(xts, o.decrypting, c.data, c.data, c.length, o.sectorSize, c.firstSector, o.threads);
+            }
+            catch(...){
+                error = std::current_exception();
+                c.length = 0;
+            }
+        }
+        else c.length = 0;
+        done.push(c);
+    }
+    done.push(Chunk{ nullptr, 0, 0 });
+    reader.join();
+    writer.join();
+    
+    for(size_t i=0; i<buffers.size(); i++) std::free(buffers[i]);
+    close(outFd);
+    if(readError) std::rethrow_exception(readError);
+    if(error) std::rethrow_exception(error);
+    if(writeError) std::rethrow_exception(writeError);
+    return total;
+}
+
+// Streams GCM a chunk at a time through one buffer, removing the output if the tag is wrong
+size_t runStreamedGcm(const Options & o, int inFd){
+    Gcm gcm(AesKey(o.key.data(), o.key.size()), GHASH_AUTO, o.engine);
+    int outFd = open(o.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(outFd < 0) throw runtime_error("Cannot create " + o.output);
+    
+    vector<unsigned char> buffer(GCM_TAG_SIZE + CHUNK_SIZE);
+    unsigned char iv[GCM_IV_SIZE];
+    size_t total = 0;
+    try{
+        if(!o.decrypting){
+            std::random_device random;
+            for(size_t i=0; i<GCM_IV_SIZE; i++) iv[i] = (unsigned char) random();
+            writeFull(outFd, iv, GCM_IV_SIZE);
+            
+            GcmStream stream(gcm, true, iv, GCM_IV_SIZE);
+            size_t n;
+            do{
+                n = readFull(inFd, buffer.data(), CHUNK_SIZE);
+                stream.update(buffer.data(), n, buffer.data());
+                writeFull(outFd, buffer.data(), n);
+                total += n;
+            } while(n == CHUNK_SIZE);
+            stream.finalize(buffer.data(), GCM_TAG_SIZE);
+            writeFull(outFd, buffer.data(), GCM_TAG_SIZE);
+        }
+        else{
+            if(readFull(inFd, iv, GCM_IV_SIZE) < GCM_IV_SIZE || readFull(inFd, buffer.data(), GCM_TAG_SIZE) < GCM_TAG_SIZE){
+                throw runtime_error("Input is too short for GCM.");
+            }
+            
+            // The last 16 bytes read could be the tag, so they stay at the front of the buffer
+            // and only what arrived before them is decrypted
+            GcmStream stream(gcm, false, iv, GCM_IV_SIZE);
+            size_t n;
+            do{
+                n = readFull(inFd, buffer.data() + GCM_TAG_SIZE, CHUNK_SIZE);
+                stream.update(buffer.data(), n, buffer.data());
+                writeFull(outFd, buffer.data(), n);
+                total += n;
+                std::memmove(buffer.data(), buffer.data() + n, GCM_TAG_SIZE);
+            } while(n == CHUNK_SIZE);
+            if(!stream.verify(buffer.data(), GCM_TAG_SIZE)) throw runtime_error("Authentication failed, no output written.");
+        }
+    }
+    catch(...){
+        close(outFd);
+        unlink(o.output.c_str());
+        throw;
+    }
+    close(outFd);
+    return total;
+}
+
+int main(int argc, char ** argv){
+    try{
+        Options o = parseOptions(argc, argv);
+        
+        // Shared lookup tables, mapped before any engine builds its own
+        std::unique_ptr<TableFile> tables;
+        if(!o.tableFile.empty()){
+            if(access(o.tableFile.c_str(), F_OK) != 0){
+                TableFileWriter writer;
+                writer.addAesTables(buildAesTables());
+                writer.write(o.tableFile);
+            }
+            tables.reset(new TableFile(o.tableFile));
+            if(tables->aesTables() == nullptr) throw runtime_error("No AES tables in " + o.tableFile);
+            installAesTables(*tables->aesTables());
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        
+        size_t bytes;
+        MappedFile in;
+        bool mapped = in.openRead(o.input);
+        if(o.mode == "gcm"){
+            if(mapped && !o.streaming) bytes = runMappedGcm(o, in);
+            else bytes = runStreamedGcm(o, in.fd());
+        }
+        else if(mapped && !o.streaming) bytes = runMappedXts(o, in);
+        else bytes = runStreamedXts(o, in.fd());
+        
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        cerr << (o.decrypting ? "decrypted " : "encrypted ") << bytes << " bytes in " << seconds
+             << " s, " << (bytes / seconds / 1e6) << " MB/s\n";
+    }
+    catch(const std::exception & e){
+        cerr << "aes_file: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
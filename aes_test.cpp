@@ -18,5 +18,17 @@ int main(){
     string ciphertext = encrypt(plaintext, key, 2);
     cout << ciphertext << "\n";
     string decrypted = decrypt(ciphertext, key, 2);
-    cout << plaintext << "\n";
+    cout << decrypted << "\n";
+    
+    // Expand the key once and reuse it
+    AesKey expanded(key, 2);
+    cout << encrypt(plaintext, expanded) << "\n";
+    cout << decrypt(ciphertext, expanded) << "\n";
+    
+    // Operation counts for one call, when built with -DAES_INSTRUMENT
+    if(instrumentEnabled()){
+        resetInstrumentation();
+        encrypt(plaintext, key, 10);
+        dumpInstrumentation(cout);
+    }
 }
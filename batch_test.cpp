@@ -0,0 +1,212 @@
+/*
+ * batch_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing the work stealing pool and the batch service
+ * against direct calls to the engines and GCM
+ */
+
+#include "lib/batch_service.h"
+#include "test_util.h"
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::string;
+using std::vector;
+
+// Tasks that spawn tasks must all run before the pool is destroyed
+bool testPoolNested(){
+    std::atomic<int> count(0);
+    {
+        ThreadPool pool(3);
+        for(int i=0; i<50; i++){
+            pool.submit([&](){
+                count++;
+                for(int j=0; j<10; j++){
+                    pool.submit([&](){ count++; });
+                }
+            });
+        }
+    }
+    return count == 50*11;
+}
+
+// One record with its own buffer and the expected result
+struct Record{
+    BatchJob job;
+    vector<unsigned char> data, expected, iv;
+    unsigned char tag[16], expectedTag[16];
+};
+
+// Mixed block and GCM records of random lengths under several keys match direct calls
+bool testServiceMatchesDirect(){
+    std::mt19937 rng(33);
+    vector<shared_ptr<const AesKey>> keys;
+    vector<shared_ptr<const Gcm>> gcms;
+    for(int k=0; k<8; k++){
+        unsigned char key[32];
+        for(int i=0; i<32; i++) key[i] = (unsigned char) rng();
+        keys.push_back(std::make_shared<AesKey>(key, 16 + 8*(k % 3)));
+        gcms.push_back(std::make_shared<Gcm>(*keys.back()));
+    }
+    
+    vector<Record> records(400);
+    for(size_t r=0; r<records.size(); r++){
+        Record & rec = records[r];
+        int k = rng() % keys.size();
+        bool gcm = rng() % 2 == 0;
+        size_t length = gcm ? rng() % 3000 : 16*(1 + rng() % 200);
+        rec.data.resize(length);
+        for(size_t i=0; i<length; i++) rec.data[i] = (unsigned char) rng();
+        rec.expected.resize(length);
+        
+        if(gcm){
+            rec.iv.resize(12);
+            for(int i=0; i<12; i++) rec.iv[i] = (unsigned char) rng();
+            gcms[k]->encrypt(rec.iv.data(), 12, nullptr, 0, rec.data.data(), rec.expected.data(), length, rec.expectedTag);
+            rec.job.mode = BATCH_GCM_ENCRYPT;
+            rec.job.gcm = gcms[k];
+            rec.job.iv = ConstByteSpan(rec.iv);
+            rec.job.tag = rec.tag;
+        }
+        else{
+            encryptBlocks(ENGINE_TABLE, *keys[k], rec.data.data(), rec.expected.data(), length / 16);
+            rec.job.mode = BATCH_ENCRYPT;
+            rec.job.key = keys[k];
+        }
+        rec.job.data = ByteSpan(rec.data);
+    }
+    
+    bool ok = true;
+    std::atomic<int> callbacks(0);
+    {
+        BatchService service(3, ENGINE_AUTO, 4096);
+        vector<std::future<bool>> results;
+        for(size_t r=0; r<records.size(); r++){
+            if(r % 2 == 0) results.push_back(service.submit(records[r].job));
+            else service.submit(records[r].job, [&](bool done){ if(done) callbacks++; });
+        }
+        for(size_t i=0; i<results.size(); i++){
+            if(!results[i].get()) ok = false;
+        }
+    }
+    
+    // Callbacks have all run once the service is gone
+    if(callbacks != (int) (records.size() / 2)) ok = false;
+    
+    for(size_t r=0; r<records.size(); r++){
+        Record & rec = records[r];
+        if(rec.data != rec.expected) ok = false;
+        if(rec.job.mode == BATCH_GCM_ENCRYPT){
+            for(int i=0; i<16; i++){
+                if(rec.tag[i] != rec.expectedTag[i]) ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+// Short block jobs in both directions under a few keys, gathered into shared engine calls, match direct calls
+bool testGatheredBlocks(){
+    std::mt19937 rng(34);
+    vector<shared_ptr<const AesKey>> keys;
+    for(int k=0; k<3; k++){
+        unsigned char key[32];
+        for(int i=0; i<32; i++) key[i] = (unsigned char) rng();
+        keys.push_back(std::make_shared<AesKey>(key, 16 + 8*k));
+    }
+    
+    vector<Record> records(600);
+    for(size_t r=0; r<records.size(); r++){
+        Record & rec = records[r];
+        int k = rng() % keys.size();
+        size_t length = 16*(1 + rng() % (BATCH_GATHER_BLOCKS + 2));
+        rec.data.resize(length);
+        for(size_t i=0; i<length; i++) rec.data[i] = (unsigned char) rng();
+        rec.expected.resize(length);
+        rec.job.mode = rng() % 2 ? BATCH_ENCRYPT : BATCH_DECRYPT;
+        if(rec.job.mode == BATCH_ENCRYPT) encryptBlocks(ENGINE_TABLE, *keys[k], rec.data.data(), rec.expected.data(), length / 16);
+        else decryptBlocks(ENGINE_TABLE, *keys[k], rec.data.data(), rec.expected.data(), length / 16);
+        rec.job.key = keys[k];
+        rec.job.data = ByteSpan(rec.data);
+    }
+    
+    bool ok = true;
+    {
+        BatchService service(2, ENGINE_AUTO, 2048);
+        vector<std::future<bool>> results;
+        for(size_t r=0; r<records.size(); r++) results.push_back(service.submit(records[r].job));
+        for(size_t i=0; i<results.size(); i++) ok &= results[i].get();
+    }
+    for(size_t r=0; r<records.size(); r++) ok &= records[r].data == records[r].expected;
+    return ok;
+}
+
+// A callback that throws neither stops the worker nor the jobs behind it
+bool testThrowingCallback(){
+    unsigned char key[16] = {0};
+    shared_ptr<const AesKey> aesKey = std::make_shared<AesKey>(key, 16);
+    vector<vector<unsigned char>> buffers(50, vector<unsigned char>(32, 1));
+    std::atomic<int> called(0);
+    {
+        BatchService service(2);
+        for(size_t i=0; i<buffers.size(); i++){
+            BatchJob job;
+            job.key = aesKey;
+            job.data = ByteSpan(buffers[i]);
+            service.submit(job, [&](bool){
+                called++;
+                throw runtime_error("Callback failed.");
+            });
+        }
+    }
+    return called == (int) buffers.size();
+}
+
+// A wrong tag comes back as false and a bad length as an exception
+bool testServiceFailures(){
+    unsigned char key[16] = {0}, iv[12] = {0}, tag[16];
+    shared_ptr<const AesKey> aesKey = std::make_shared<AesKey>(key, 16);
+    shared_ptr<const Gcm> gcm = std::make_shared<Gcm>(*aesKey);
+    vector<unsigned char> data(40, 7), odd(20, 7);
+    gcm->encrypt(iv, 12, nullptr, 0, data.data(), data.data(), data.size(), tag);
+    tag[3] ^= 1;
+    
+    BatchService service(2);
+    BatchJob open;
+    open.mode = BATCH_GCM_DECRYPT;
+    open.gcm = gcm;
+    open.data = ByteSpan(data);
+    open.iv = ConstByteSpan(iv, 12);
+    open.tag = tag;
+    bool ok = !service.submit(open).get();
+    
+    BatchJob blocks;
+    blocks.mode = BATCH_ENCRYPT;
+    blocks.key = aesKey;
+    blocks.data = ByteSpan(odd);
+    std::future<bool> f = service.submit(blocks);
+    try{
+        f.get();
+        ok = false;
+    }
+    catch(const runtime_error &){}
+    return ok;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("Nested pool tasks all run", testPoolNested());
+    ok &= report("Batch service matches direct calls", testServiceMatchesDirect());
+    ok &= report("Short block jobs gathered under shared keys", testGatheredBlocks());
+    ok &= report("Throwing callbacks are contained", testThrowingCallback());
+    ok &= report("Batch service reports failures", testServiceFailures());
+    
+    return ok ? 0 : 1;
+}
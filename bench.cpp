@@ -0,0 +1,618 @@
+/*
+ * bench.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Microbenchmarks for every layer, from Modular arithmetic
+ * up through the block engines, modes, streams, CMAC and batch service,
+ * the start up cost of building or mapping the tables, and
+ * reduced round integral experiments.
+ * Each case reports ns/op, cycles and MB/s, and keys/s for
+ * cases that set up a new key per block, as a table or as
+ * JSON for tracking regressions between versions.
+ * 
+ * usage: bench [--json] [--quick] [filter]
+ *   --json   print results as JSON instead of a table
+ *   --quick  shorter timing runs
+ *   filter   only run cases whose group/name contains it
+ */
+
+#include "lib/aes.h"
+#include "lib/batch_service.h"
+#include "lib/cipher_stream.h"
+#include "lib/circulant_mds.h"
+#include "lib/cmac.h"
+#include "lib/cpu_features.h"
+#include "lib/field_tables.h"
+#include "lib/frobenius.h"
+#include "lib/gcm.h"
+#include "lib/integral.h"
+#include "lib/irreducible.h"
+#include "lib/parallel.h"
+#include "lib/sbox_analysis.h"
+#include "lib/table_file.h"
+#include "lib/xts.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef AES_X86
+#include <x86intrin.h>
+#endif
+
+using std::cout;
+using std::vector;
+using std::uint64_t;
+
+typedef std::chrono::steady_clock Clock;
+
+/*
+ * Result
+ * One timed case. Latencies are only set for the batch service.
+ */
+struct Result{
+    string group;
+    string name;
+    size_t bytes;           // Bytes processed per op, 0 for field operations
+    size_t keys;            // Keys set up per op, 0 when the key is reused
+    int threads;
+    size_t iterations;
+    double nsPerOp;
+    double cyclesPerOp;     // Negative when there is no cycle counter
+    double p50, p99, p999;  // Latencies in microseconds, negative when not measured
+};
+
+// Settings from the command line
+static double minSeconds = 0.2;
+static string filter;
+static vector<Result> results;
+// Results of field operations land here so they are not optimized away
+static volatile int sink;
+
+// Seconds since start
+double elapsed(Clock::time_point start){
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Time stamp counter, or 0 where there is none
+uint64_t cycleCount(){
+#ifdef AES_X86
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Whether a case is selected by the filter
+bool selected(const string & group, const string & name){
+    return filter.empty() || (group + "/" + name).find(filter) != string::npos;
+}
+
+// Runs op until minSeconds have passed and records the time per op
+template<typename Op>
+void measure(const string & group, const string & name, size_t bytes, int threads, Op op, size_t keys = 0){
+    if(!selected(group, name)) return;
+    op();
+    
+    size_t iterations = 1;
+    double seconds = 0;
+    uint64_t cycles = 0;
+    while(true){
+        uint64_t c0 = cycleCount();
+        Clock::time_point start = Clock::now();
+        for(size_t i=0; i<iterations; i++){
+            op();
+        }
+        seconds = elapsed(start);
+        cycles = cycleCount() - c0;
+        if(seconds >= minSeconds) break;
+        
+        // Aim a little past minSeconds next time
+        double scale = seconds > 0 ? 1.2*minSeconds/seconds : 100;
+        iterations = (size_t) (iterations * std::min(std::max(scale, 2.0), 100.0));
+    }
+    
+    Result r = { group, name, bytes, keys, threads, iterations, 1e9*seconds/iterations,
+                 cycles != 0 ? (double) cycles/iterations : -1, -1, -1, -1 };
+    results.push_back(r);
+}
+
+// Formats a size as B, KB or MB
+string sizeName(size_t bytes){
+    std::ostringstream s;
+    if(bytes >= (1 << 20)) s << (bytes >> 20) << "MB";
+    else if(bytes >= 1024) s << (bytes >> 10) << "KB";
+    else s << bytes << "B";
+    return s.str();
+}
+
+// Field arithmetic: Modular, Polynomial and GaloisPolynomial
+void benchField(std::mt19937 & rng){
+    Modular<int>::globalSetModulus(251);
+    Modular<int> a(rng() % 250 + 1), b(rng() % 250 + 1);
+    measure("field", "Modular<int> add", 0, 1, [&](){ a += b; sink = a.value(); });
+    measure("field", "Modular<int> multiply", 0, 1, [&](){ a *= b; sink = a.value(); });
+    measure("field", "Modular<int> inverse", 0, 1, [&](){ sink = b.mulInverse().value(); });
+    Modular<int>::globalSetModulus(2);
+    
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    Polynomial p(rng() % 256), q(rng() % 256);
+    measure("field", "Polynomial multiply, degree 7", 0, 1, [&](){ sink = (p * q).size(); });
+    Polynomial pq = p * q;
+    measure("field", "Polynomial mod rijndael_Mod", 0, 1, [&](){ sink = (pq % rijndael_Mod).size(); });
+    
+    vector<Modular<int>> coef;
+    for(int i=0; i<128; i++) coef.push_back(rng() % 2);
+    Polynomial big(coef), other(coef);
+    measure("field", "Polynomial multiply, degree 127", 0, 1, [&](){ sink = (big * other).size(); });
+    Polynomial product = big * other;
+    measure("field", "Polynomial mod gcm_Mod", 0, 1, [&](){ sink = (product % gcm_Mod).size(); });
+    
+    vector<Modular<int>> b163(164, 0), b233(234, 0), denseCoef(164, 1);
+    b163[163] = b163[7] = b163[6] = b163[3] = b163[0] = 1;
+    b233[233] = b233[74] = b233[0] = 1;
+    Polynomial nist163(b163), nist233(b233), dense163(denseCoef);
+    vector<Modular<int>> wide;
+    for(int i=0; i<325; i++) wide.push_back(rng() % 2);
+    Polynomial product163(wide);
+    measure("field", "Polynomial mod B-163 pentanomial", 0, 1, [&](){ sink = (product163 % nist163).size(); });
+    measure("field", "Polynomial mod dense, degree 163", 0, 1, [&](){ sink = (product163 % dense163).size(); });
+    GaloisPolynomial::globalSetModulus(nist233);
+    vector<Modular<int>> c233, d233;
+    for(int i=0; i<233; i++){
+        c233.push_back(rng() % 2);
+        d233.push_back(rng() % 2);
+    }
+    GaloisPolynomial e233(c233), f233(d233);
+    measure("field", "GaloisPolynomial multiply, B-233", 0, 1, [&](){ sink = (e233 * f233).size(); });
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    
+    GaloisPolynomial g(rng() % 255 + 1), h(rng() % 255 + 1);
+    measure("field", "GaloisPolynomial multiply", 0, 1, [&](){ sink = (g * h).toInt(); });
+    measure("field", "GaloisPolynomial inverse", 0, 1, [&](){ sink = g.inverse().toInt(); });
+    
+    // Powering: the spread square against a product, Fermat inversion, and Frobenius matrices
+    measure("field", "Polynomial square, degree 127", 0, 1, [&](){ sink = big.square().size(); });
+    measure("field", "GaloisPolynomial inverse by Fermat", 0, 1, [&](){ sink = g.inverseByFermat().toInt(); });
+    measure("field", "GaloisPolynomial pow, 8 bit", 0, 1, [&](){ sink = g.pow(Exponent(200)).toInt(); });
+    Exponent order = Exponent::power(2, 128);
+    measure("field", "Polynomial powMod gcm_Mod, 2^128", 0, 1, [&](){ sink = big.powMod(order, gcm_Mod).size(); });
+    FrobeniusMap frobenius(gcm_Mod, 64);
+    Polynomial reduced = big % gcm_Mod;
+    measure("field", "Frobenius matrix, x^(2^64) gcm_Mod", 0, 1, [&](){ sink = frobenius.apply(reduced).size(); });
+    
+    // Whole field tables, Euclid per element against generator powering
+    measure("tables", "GF(2^8) inverses by Euclid", 0, 1, [&](){
+        for(int x=1; x<256; x++) sink = GaloisPolynomial(x).inverse().toInt();
+    });
+    measure("tables", "GF(2^8) exp/log/inverse", 0, 1, [&](){ sink = FieldTables(rijndael_Mod, 1).inverse(2); });
+    Polynomial mod16(0x1100b, 2, 17);
+    measure("tables", "GF(2^16) exp/log/inverse", 0, 1, [&](){ sink = FieldTables(mod16, 1).inverse(2); });
+    int threads = defaultThreadCount();
+    measure("tables", "GF(2^16) exp/log/inverse", 0, threads, [&](){ sink = FieldTables(mod16, threads).inverse(2); });
+    
+    // Irreducibility of large moduli and enumerating every modulus of a degree
+    measure("tables", "Rabin test, gcm_Mod", 0, 1, [&](){ sink = isIrreducible(gcm_Mod); });
+    measure("tables", "Rabin test, degree 233", 0, 1, [&](){ sink = isIrreducible(nist233); });
+    measure("tables", "Ben-Or test, degree 233", 0, 1, [&](){ sink = isIrreducibleBenOr(nist233); });
+    measure("tables", "sparse search, degree 163", 0, 1, [&](){ sink = sparseIrreducible(2, 163).size(); });
+    measure("tables", "irreducibles of degree 16", 0, 1, [&](){ sink = irreduciblePolynomials(2, 16, 1).size(); });
+    measure("tables", "irreducibles of degree 16", 0, threads, [&](){ sink = irreduciblePolynomials(2, 16, threads).size(); });
+    
+    // S-Box measures, the linear table by transform against direct sums
+    vector<uint32_t> sbox(aesTables().sbox, aesTables().sbox + 256);
+    measure("analysis", "difference table, 8 bit", 0, 1, [&](){ sink = differenceTable(sbox, 1)[257]; });
+    measure("analysis", "linear table by transform, 8 bit", 0, 1, [&](){ sink = linearTable(sbox, 1)[257]; });
+    measure("analysis", "linear table direct, 8 bit", 0, 1, [&](){ sink = linearTableDirect(sbox)[257]; });
+    measure("analysis", "full profile, 8 bit", 0, threads, [&](){ sink = analyzeSBox(sbox, threads).nonlinearity; });
+    
+    // Reduced round lambda sets, each with its own key, and the four round attack
+    const size_t setBytes = AES_BLOCK_SIZE*LAMBDA_SET_SIZE;
+    measure("integral", "4 round lambda set, table", setBytes, 1, [&](){ sink = integralTest(4, 1, 1, ENGINE_TABLE).balancedBytes; });
+    measure("integral", "4 round lambda set", setBytes, 1, [&](){ sink = integralTest(4, 1, 1).balancedBytes; });
+    measure("integral", "4 round lambda sets, 64", 64*setBytes, threads, [&](){ sink = integralTest(4, 64, threads).balancedBytes; });
+    unsigned char secret[16] = {0};
+    AesKey oracleKey(secret, 16, 4);
+    EncryptionOracle oracle = [&](const unsigned char * in, unsigned char * out, size_t blocks){
+        encryptBlocks(ENGINE_AUTO, oracleKey, in, out, blocks);
+    };
+    measure("integral", "4 round square attack", 0, threads, [&](){ sink = squareAttack(oracle, threads).lambdaSets; });
+}
+
+// Steps of the polynomial implementation of AES
+void benchMath(std::mt19937 & rng){
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    measure("math", "sBox", 0, 1, [&](){
+        GaloisPolynomial x(rng() % 256);
+        sink = sBox(x).toInt();
+    });
+    
+    vector<GaloisPolynomial> v;
+    for(int i=0; i<16; i++) v.push_back(GaloisPolynomial(rng() % 256));
+    QSMatrix<GaloisPolynomial> state(4, 4, v);
+    measure("math", "mixColumns", 16, 1, [&](){ mixColumns(state); });
+    measure("math", "mixColumns, general product", 16, 1, [&](){ state = rijndael_M * state; });
+    measure("math", "mixColumns_inverse", 16, 1, [&](){ mixColumns_inverse(state); });
+    measure("math", "mixColumns_inverse, general", 16, 1, [&](){ state = rijndael_M_inverse * state; });
+    unsigned char columns[16];
+    for(int i=0; i<16; i++) columns[i] = (unsigned char) rng();
+    measure("math", "circulant mix, bytes", 16, 1, [&](){
+        for(int c=0; c<4; c++) AesMixLayer::apply(columns + 4*c);
+        sink = columns[0];
+    });
+    measure("math", "circulant mix inverse, bytes", 16, 1, [&](){
+        for(int c=0; c<4; c++) aesMixLayer_inverse(columns + 4*c);
+        sink = columns[0];
+    });
+    
+    vector<unsigned char> key(16);
+    for(int i=0; i<16; i++) key[i] = (unsigned char) rng();
+    measure("math", "expandKey, 128 bit", 0, 1, [&](){ sink = expandKey(key, 10).size(); });
+    
+    string block(16, 'a'), skey(key.begin(), key.end());
+    measure("math", "encrypt, 1 block", 16, 1, [&](){ block = encrypt(block, skey); });
+    measure("math", "decrypt, 1 block", 16, 1, [&](){ block = decrypt(block, skey); });
+}
+
+// Key setup for both schedules and single blocks on every engine
+void benchEngines(std::mt19937 & rng){
+    unsigned char key[32], block[16];
+    for(int i=0; i<32; i++) key[i] = (unsigned char) rng();
+    for(int i=0; i<16; i++) block[i] = (unsigned char) rng();
+    
+    int lengths[3] = { 16, 24, 32 };
+    for(int k=0; k<3; k++){
+        string bits = std::to_string(8*lengths[k]);
+        measure("keys", "AesKey, " + bits + " bit", 0, 1, [&](){
+            AesKey expanded(key, lengths[k]);
+            sink = expanded.encryptionKeys()[16];
+        });
+        measure("keys", "AesCompactKey, " + bits + " bit", 0, 1, [&](){
+            AesCompactKey compact(key, lengths[k]);
+            sink = compact.lastKey()[0];
+        });
+    }
+    
+    AesKey expanded(key, 16);
+    AesCompactKey compact(key, 16);
+    AesEngine engines[2] = { ENGINE_TABLE, ENGINE_HARDWARE };
+    string names[2] = { "table", "hardware" };
+    for(int e=0; e<2; e++){
+        if(resolveEngine(engines[e]) != engines[e]) continue;
+        measure("block", names[e] + " encrypt", 16, 1, [&](){ encryptBlocks(engines[e], expanded, block, block, 1); });
+        measure("block", names[e] + " decrypt", 16, 1, [&](){ decryptBlocks(engines[e], expanded, block, block, 1); });
+    }
+    measure("block", "on the fly encrypt", 16, 1, [&](){ encryptBlocks(compact, block, block, 1); });
+    measure("block", "on the fly decrypt", 16, 1, [&](){ decryptBlocks(compact, block, block, 1); });
+    
+    // A fresh key for every block, key setup included
+    measure("block", "new AesKey per block", 16, 1, [&](){
+        AesKey fresh(key, 16);
+        encryptBlocks(ENGINE_TABLE, fresh, block, block, 1);
+        key[0] = block[0];
+    }, 1);
+    measure("block", "new AesCompactKey per block", 16, 1, [&](){
+        AesCompactKey fresh(key, 16);
+        encryptBlocks(fresh, block, block, 1);
+        key[0] = block[0];
+    }, 1);
+    
+    // One block under each of many keys, all set up inside the batch
+    const size_t pairs = 1024;
+    vector<unsigned char> keys(32*pairs), blocks(16*pairs);
+    for(size_t i=0; i<keys.size(); i++) keys[i] = (unsigned char) rng();
+    for(size_t i=0; i<blocks.size(); i++) blocks[i] = (unsigned char) rng();
+    for(int k=0; k<3; k++){
+        string bits = std::to_string(8*lengths[k]);
+        for(int e=0; e<2; e++){
+            if(resolveEngine(engines[e]) != engines[e]) continue;
+            measure("multikey", names[e] + " " + bits + " bit, 1024 keys", blocks.size(), 1, [&](){
+                encryptBlocksMultiKey(engines[e], keys.data(), lengths[k], keyWords(lengths[k]) + 6,
+                                      blocks.data(), blocks.data(), pairs);
+            }, pairs);
+        }
+    }
+}
+
+// Getting the lookup tables at start up: built from the field, or mapped from a table file
+void benchStartup(){
+    measure("startup", "build AesTables", sizeof(AesTables), 1, [&](){ sink = buildAesTables().te[0][1]; });
+    
+    const string path = "bench_tables.tmp";
+    TableFileWriter writer;
+    writer.addAesTables(aesTables());
+    writer.write(path);
+    measure("startup", "map table file, verified", sizeof(AesTables), 1, [&](){
+        TableFile file(path);
+        sink = file.aesTables()->te[0][1];
+    });
+    measure("startup", "map table file, unverified", sizeof(AesTables), 1, [&](){
+        TableFile file(path, false);
+        sink = file.aesTables()->te[0][1];
+    });
+    std::remove(path.c_str());
+}
+
+// Block engines, GCM and XTS over a range of message sizes
+void benchModes(std::mt19937 & rng){
+    unsigned char key[32], iv[16], tag[16];
+    for(int i=0; i<32; i++) key[i] = (unsigned char) rng();
+    for(int i=0; i<16; i++) iv[i] = (unsigned char) rng();
+    AesKey aesKey(key, 16), tweakKey(key + 16, 16);
+    
+    size_t sizes[5] = { 16, 256, 4096, 65536, 1 << 20 };
+    vector<unsigned char> data(sizes[4]);
+    for(size_t i=0; i<data.size(); i++) data[i] = (unsigned char) rng();
+    
+    AesEngine engines[2] = { ENGINE_TABLE, ENGINE_HARDWARE };
+    string engineNames[2] = { "table", "hardware" };
+    GhashMethod methods[3] = { GHASH_TABLE4, GHASH_TABLE8, GHASH_CLMUL };
+    string methodNames[3] = { "4 bit tables", "8 bit tables", "clmul" };
+    
+    for(int s=0; s<5; s++){
+        size_t n = sizes[s];
+        string size = sizeName(n);
+        for(int e=0; e<2; e++){
+            if(resolveEngine(engines[e]) != engines[e]) continue;
+            measure("ecb", engineNames[e] + " encrypt " + size, n, 1, [&](){
+                encryptBlocks(engines[e], aesKey, data.data(), data.data(), n / 16);
+            });
+            measure("ecb", engineNames[e] + " decrypt " + size, n, 1, [&](){
+                decryptBlocks(engines[e], aesKey, data.data(), data.data(), n / 16);
+            });
+            
+            Xts xts(aesKey, tweakKey, engines[e]);
+            measure("xts", engineNames[e] + " encrypt " + size, n, 1, [&](){
+                xts.encryptUnit(iv, data.data(), data.data(), n);
+            });
+            
+            Cmac cmac(aesKey, engines[e]);
+            measure("cmac", engineNames[e] + " " + size, n, 1, [&](){ cmac.mac(data.data(), n, tag); });
+        }
+        for(int m=0; m<3; m++){
+            if(methods[m] == GHASH_CLMUL && !cpuHasClmul()) continue;
+            Gcm gcm(aesKey, methods[m]);
+            measure("gcm", methodNames[m] + " encrypt " + size, n, 1, [&](){
+                gcm.encrypt(iv, 12, nullptr, 0, data.data(), data.data(), n, tag);
+            });
+        }
+    }
+    
+    // Independent blocks one per call, against whole buffers that the engines run several blocks at a time
+    for(int e=0; e<2; e++){
+        if(resolveEngine(engines[e]) != engines[e]) continue;
+        size_t bytes = 65536;
+        measure("interleave", engineNames[e] + " encrypt 64KB one block per call", bytes, 1, [&](){
+            for(size_t b=0; b<bytes/16; b++) encryptBlocks(engines[e], aesKey, data.data() + 16*b, data.data() + 16*b, 1);
+        });
+        measure("interleave", engineNames[e] + " encrypt 64KB interleaved", bytes, 1, [&](){
+            encryptBlocks(engines[e], aesKey, data.data(), data.data(), bytes / 16);
+        });
+        measure("interleave", engineNames[e] + " decrypt 64KB one block per call", bytes, 1, [&](){
+            for(size_t b=0; b<bytes/16; b++) decryptBlocks(engines[e], aesKey, data.data() + 16*b, data.data() + 16*b, 1);
+        });
+        measure("interleave", engineNames[e] + " decrypt 64KB interleaved", bytes, 1, [&](){
+            decryptBlocks(engines[e], aesKey, data.data(), data.data(), bytes / 16);
+        });
+    }
+    
+    // Streams fed network sized pieces, against the same 64 KB in one call
+    size_t piece = 1500, total = 65536;
+    vector<unsigned char> out(total + 16);
+    CipherStream ctr(aesKey, MODE_CTR, true, iv), cbc(aesKey, MODE_CBC, false, iv);
+    measure("stream", "ctr encrypt 64KB whole", total, 1, [&](){ ctr.update(data.data(), total, data.data()); });
+    measure("stream", "ctr encrypt 64KB in 1500 byte pieces", total, 1, [&](){
+        for(size_t done=0; done<total; done+=piece) ctr.update(data.data() + done, std::min(piece, total - done), data.data() + done);
+    });
+    measure("stream", "cbc decrypt 64KB in 1500 byte pieces", total, 1, [&](){
+        size_t written = 0;
+        for(size_t done=0; done<total; done+=piece) written += cbc.update(data.data() + done, std::min(piece, total - done), out.data() + written);
+    });
+    Gcm gcm(aesKey);
+    GcmStream gcmStream(gcm, true, iv, 12);
+    measure("stream", "gcm encrypt 64KB in 1500 byte pieces", total, 1, [&](){
+        gcmStream.reset(iv, 12);
+        for(size_t done=0; done<total; done+=piece) gcmStream.update(data.data() + done, std::min(piece, total - done), data.data() + done);
+        gcmStream.finalize(tag);
+    });
+    
+    // Many 4 KB sectors spread over threads
+    Xts xts(aesKey, tweakKey);
+    int threadCounts[4] = { 1, 2, 4, 8 };
+    for(int t=0; t<4; t++){
+        measure("xts", "sectors 1MB", data.size(), threadCounts[t], [&](){
+            xts.encryptSectors(data.data(), data.data(), 4096, data.size() / 4096, 0, threadCounts[t]);
+        });
+    }
+}
+
+// Stores the median and tail of a set of latencies in a result
+void setLatency(Result & r, vector<double> latencies){
+    std::sort(latencies.begin(), latencies.end());
+    size_t n = latencies.size();
+    r.p50 = latencies[n/2]*1e6;
+    r.p99 = latencies[n*99/100]*1e6;
+    r.p999 = latencies[n*999/1000]*1e6;
+}
+
+// Synthetic records: log uniform lengths from 16 bytes to 16 KB, half GCM, keys from a pool
+struct RecordLoad{
+    vector<shared_ptr<const AesKey>> keys;
+    vector<shared_ptr<const Gcm>> gcms;
+    vector<vector<unsigned char>> buffers;
+    vector<BatchJob> jobs;
+    vector<unsigned char> iv;
+    vector<unsigned char> tags;
+    size_t bytes;
+    
+    RecordLoad(size_t records, std::mt19937 & rng): iv(12, 0), tags(16*records), bytes(0) {
+        for(int k=0; k<64; k++){
+            unsigned char key[16];
+            for(int i=0; i<16; i++) key[i] = (unsigned char) rng();
+            keys.push_back(std::make_shared<AesKey>(key, 16));
+            gcms.push_back(std::make_shared<Gcm>(*keys.back()));
+        }
+        std::uniform_real_distribution<double> logLength(4, 14);
+        buffers.resize(records);
+        jobs.resize(records);
+        for(size_t r=0; r<records; r++){
+            size_t length = ((size_t) std::pow(2.0, logLength(rng)) + 15) / 16 * 16;
+            buffers[r].assign(length, (unsigned char) r);
+            bytes += length;
+            BatchJob & job = jobs[r];
+            int k = rng() % keys.size();
+            if(rng() % 2 == 0){
+                job.mode = BATCH_GCM_ENCRYPT;
+                job.gcm = gcms[k];
+                job.iv = ConstByteSpan(iv);
+                job.tag = tags.data() + 16*r;
+            }
+            else{
+                job.mode = BATCH_ENCRYPT;
+                job.key = keys[k];
+            }
+            job.data = ByteSpan(buffers[r]);
+        }
+    }
+};
+
+// Runs the load through the batch service, submitting every gap seconds (0 for all at once)
+void benchServiceLoad(const string & name, RecordLoad & load, int threads, double gap){
+    if(!selected("service", name)) return;
+    size_t n = load.jobs.size();
+    vector<double> latencies(n);
+    Clock::time_point start = Clock::now();
+    {
+        BatchService service(threads);
+        for(size_t r=0; r<n; r++){
+            Clock::time_point submitted = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(gap*r));
+            std::this_thread::sleep_until(submitted);
+            service.submit(load.jobs[r], [&latencies, r, submitted](bool){
+                latencies[r] = std::chrono::duration<double>(Clock::now() - submitted).count();
+            });
+        }
+    }
+    double seconds = elapsed(start);
+    
+    Result result = { "service", name, load.bytes, 0, threads, 1, 1e9*seconds, -1, -1, -1, -1 };
+    setLatency(result, latencies);
+    results.push_back(result);
+}
+
+// Records one at a time on the caller against the batch service, all arriving together and paced
+void benchService(std::mt19937 & rng){
+    RecordLoad load(minSeconds < 0.1 ? 2000 : 20000, rng);
+    size_t n = load.jobs.size();
+    
+    // Everything arrives at once and runs in order on the caller
+    vector<double> latencies(n);
+    Clock::time_point start = Clock::now();
+    for(size_t r=0; r<n; r++){
+        const BatchJob & job = load.jobs[r];
+        if(job.mode == BATCH_ENCRYPT) encrypt(job.data, job.data, *job.key);
+        else job.gcm->encrypt(job.iv.data, job.iv.size, nullptr, 0, job.data.data, job.data.data, job.data.size, job.tag);
+        latencies[r] = elapsed(start);
+    }
+    double seconds = elapsed(start);
+    if(selected("service", "synchronous burst")){
+        Result result = { "service", "synchronous burst", load.bytes, 0, 1, 1, 1e9*seconds, -1, -1, -1, -1 };
+        setLatency(result, latencies);
+        results.push_back(result);
+    }
+    
+    int threadCounts[3] = { 1, 2, 4 };
+    for(int t=0; t<3; t++){
+        benchServiceLoad("burst", load, threadCounts[t], 0);
+        // Paced at half the synchronous rate, latency is then mostly service time
+        benchServiceLoad("paced", load, threadCounts[t], 2*seconds/n);
+    }
+}
+
+// Escapes a string for JSON
+string jsonString(const string & s){
+    string out = "\"";
+    for(size_t i=0; i<s.size(); i++){
+        if(s[i] == '"' || s[i] == '\\') out += '\\';
+        out += s[i];
+    }
+    return out + "\"";
+}
+
+// Writes a number, or null when it was not measured
+string jsonNumber(double x){
+    if(x < 0) return "null";
+    std::ostringstream s;
+    s << std::setprecision(6) << x;
+    return s.str();
+}
+
+// Prints every result as one JSON document
+void printJson(){
+    cout << "{\n  \"schema\": 1,\n  \"hardware_threads\": " << defaultThreadCount()
+         << ",\n  \"aesni\": " << (cpuHasAesni() ? "true" : "false")
+         << ",\n  \"clmul\": " << (cpuHasClmul() ? "true" : "false") << ",\n  \"results\": [\n";
+    for(size_t i=0; i<results.size(); i++){
+        const Result & r = results[i];
+        double mbPerSecond = r.bytes == 0 ? -1 : r.bytes / r.nsPerOp * 1e3;
+        double cyclesPerByte = r.bytes == 0 || r.cyclesPerOp < 0 ? -1 : r.cyclesPerOp / r.bytes;
+        double keysPerSecond = r.keys == 0 ? -1 : r.keys / r.nsPerOp * 1e9;
+        cout << "    {\"group\": " << jsonString(r.group) << ", \"name\": " << jsonString(r.name)
+             << ", \"bytes\": " << r.bytes << ", \"threads\": " << r.threads
+             << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << jsonNumber(r.nsPerOp)
+             << ", \"cycles_per_op\": " << jsonNumber(r.cyclesPerOp)
+             << ", \"cycles_per_byte\": " << jsonNumber(cyclesPerByte)
+             << ", \"mb_per_s\": " << jsonNumber(mbPerSecond)
+             << ", \"keys_per_s\": " << jsonNumber(keysPerSecond)
+             << ", \"p50_us\": " << jsonNumber(r.p50) << ", \"p99_us\": " << jsonNumber(r.p99)
+             << ", \"p999_us\": " << jsonNumber(r.p999) << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    cout << "  ]\n}\n";
+}
+
+// Prints every result as a table
+void printTable(){
+    cout << std::left << std::setw(40) << "case" << std::right << std::setw(8) << "threads"
+         << std::setw(14) << "ns/op" << std::setw(12) << "cycles/B" << std::setw(10) << "MB/s" << std::setw(12) << "Mkeys/s" << "\n";
+    for(size_t i=0; i<results.size(); i++){
+        const Result & r = results[i];
+        cout << std::left << std::setw(40) << (r.group + "/" + r.name) << std::right << std::setw(8) << r.threads
+             << std::setw(14) << std::fixed << std::setprecision(1) << r.nsPerOp;
+        if(r.bytes != 0 && r.cyclesPerOp >= 0) cout << std::setw(12) << std::setprecision(2) << r.cyclesPerOp / r.bytes;
+        else cout << std::setw(12) << "-";
+        if(r.bytes != 0) cout << std::setw(10) << std::setprecision(1) << r.bytes / r.nsPerOp * 1e3;
+        else cout << std::setw(10) << "-";
+        if(r.keys != 0) cout << std::setw(12) << std::setprecision(2) << r.keys / r.nsPerOp * 1e3;
+        else cout << std::setw(12) << "-";
+        if(r.p50 >= 0) cout << "   p50 " << r.p50 << " us, p99 " << r.p99 << " us, p99.9 " << r.p999 << " us";
+        cout << "\n";
+    }
+}
+
+int main(int argc, char ** argv){
+    bool json = false;
+    for(int i=1; i<argc; i++){
+        string arg = argv[i];
+        if(arg == "--json") json = true;
+        else if(arg == "--quick") minSeconds = 0.02;
+        else filter = arg;
+    }
+    
+    std::mt19937 rng(197);
+    benchField(rng);
+    benchMath(rng);
+    benchEngines(rng);
+    benchStartup();
+    benchModes(rng);
+    benchService(rng);
+    
+    if(json) printJson();
+    else printTable();
+    return 0;
+}
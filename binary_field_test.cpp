@@ -0,0 +1,154 @@
+/*
+ * binary_field_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing the packed GF(2) product and the sparse and dense
+ * reductions against schoolbook arithmetic on plain bit arrays,
+ * in fields from GF(2^8) up to the NIST binary curve fields, and
+ * the packed and long division GCDs.
+ */
+
+#include "lib/aes.h"
+#include "lib/gcm.h"
+#include "test_util.h"
+#include <iostream>
+#include <random>
+#include <string>
+
+using std::cout;
+using std::string;
+
+// Polynomial over GF(p) with the given coefficients, lowest first
+Polynomial fromDigits(const vector<int> & c, int p){
+    return Polynomial(vector<Modular<int>>(c.begin(), c.end()), p);
+}
+
+// Coefficients of a padded to n, lowest first
+vector<int> digits(const Polynomial & a, int n){
+    vector<int> c(n, 0);
+    for(int i=0; i<a.size(); i++) c[i] = a[i].value();
+    return c;
+}
+
+// Schoolbook product and long division over GF(p), the reference for the fast paths
+vector<int> referenceMultiplyMod(const vector<int> & a, const vector<int> & b, const vector<int> & f, int p){
+    vector<int> r(a.size() + b.size(), 0);
+    for(size_t i=0; i<a.size(); i++){
+        for(size_t j=0; j<b.size(); j++) r[i+j] = (r[i+j] + a[i]*b[j]) % p;
+    }
+    int n = f.size() - 1, leadInverse = 1;
+    for(int i=0; i<p-2; i++) leadInverse = leadInverse * f[n] % p;
+    for(int k=(int) r.size()-1; k>=n; k--){
+        int c = r[k] * leadInverse % p;
+        for(int j=0; j<=n; j++) r[k-n+j] = ((r[k-n+j] - c*f[j]) % p + p) % p;
+    }
+    r.resize(n);
+    return r;
+}
+
+// Random coefficients below p
+vector<int> randomDigits(std::mt19937 & rng, int n, int p){
+    vector<int> c(n);
+    for(int i=0; i<n; i++) c[i] = rng() % p;
+    return c;
+}
+
+// Modulus of degree n over GF(p) with the given middle terms set to 1
+vector<int> modulusDigits(int n, const vector<int> & terms){
+    vector<int> f(n + 1, 0);
+    f[0] = f[n] = 1;
+    for(size_t i=0; i<terms.size(); i++) f[terms[i]] = 1;
+    return f;
+}
+
+// Products reduced by trinomials, pentanomials and a dense modulus match the reference
+bool testBinaryReduction(){
+    std::mt19937 rng(48);
+    vector<vector<int>> moduli = {
+        modulusDigits(8, { 1, 3, 4 }),          // rijndael_Mod
+        modulusDigits(128, { 1, 2, 7 }),        // gcm_Mod
+        modulusDigits(163, { 3, 6, 7 }),        // NIST B-163
+        modulusDigits(233, { 74 }),             // NIST B-233
+        modulusDigits(7, { 6 }),                // Middle term just under the top
+        modulusDigits(100, { 3, 8, 13, 21, 34, 55, 89, 97 })
+    };
+    bool ok = true;
+    for(const vector<int> & f : moduli){
+        int n = f.size() - 1;
+        Polynomial modulus = fromDigits(f, 2);
+        for(int trial=0; trial<20; trial++){
+            vector<int> a = randomDigits(rng, n, 2), b = randomDigits(rng, n, 2);
+            Polynomial product = (fromDigits(a, 2) * fromDigits(b, 2)) % modulus;
+            ok &= digits(product, n) == referenceMultiplyMod(a, b, f, 2);
+        }
+    }
+    return ok;
+}
+
+// Odd primes go through long division in place
+bool testOddReduction(){
+    std::mt19937 rng(49);
+    bool ok = true;
+    int primes[] = { 3, 5, 7 };
+    for(int p : primes){
+        vector<int> f = randomDigits(rng, 13, p);
+        f.push_back(1 + rng() % (p - 1));
+        Polynomial modulus = fromDigits(f, p);
+        for(int trial=0; trial<20; trial++){
+            vector<int> a = randomDigits(rng, 13, p), b = randomDigits(rng, 13, p);
+            Polynomial product = (fromDigits(a, p) * fromDigits(b, p)) % modulus;
+            ok &= digits(product, 13) == referenceMultiplyMod(a, b, f, p);
+        }
+    }
+    return ok;
+}
+
+// Greatest common divisors of products with a shared factor divide both and are divided by it, and are monic
+bool testGcd(){
+    std::mt19937 rng(51);
+    bool ok = true;
+    int primes[] = { 2, 3, 5 };
+    for(int p : primes){
+        for(int trial=0; trial<10; trial++){
+            vector<int> shared = randomDigits(rng, 40, p);
+            shared.push_back(1 + rng() % (p - 1));
+            Polynomial c = fromDigits(shared, p);
+            Polynomial a = fromDigits(randomDigits(rng, 110, p), p) * c, b = fromDigits(randomDigits(rng, 90, p), p) * c;
+            Polynomial g = a.gcd(b);
+            ok &= (a % g).size() == 0 && (b % g).size() == 0 && (g % c).size() == 0;
+            ok &= g[g.size() - 1].value() == 1 && b.gcd(a).toString() == g.toString();
+        }
+        Polynomial one = fromDigits({ 1 }, p), x = fromDigits({ 0, 1 }, p), zero(0, p, 0);
+        ok &= x.gcd(x + one).toString() == one.toString() && x.gcd(zero).toString() == x.toString();
+        ok &= zero.gcd(zero).size() == 0;
+    }
+    return ok;
+}
+
+// Field identities in GF(2^163) and GF(2^233): a^(2^n) = a and a times its inverse is 1
+bool testLargeFields(){
+    std::mt19937 rng(50);
+    vector<vector<int>> moduli = { modulusDigits(163, { 3, 6, 7 }), modulusDigits(233, { 74 }) };
+    bool ok = true;
+    for(const vector<int> & f : moduli){
+        int n = f.size() - 1;
+        GaloisPolynomial::globalSetModulus(fromDigits(f, 2));
+        GaloisPolynomial a(fromDigits(randomDigits(rng, n, 2), 2));
+        ok &= a.pow(Exponent::power(2, n)).toString() == a.toString();
+        ok &= (a * a.inverseByFermat()).toInt() == 1 && (a * a.inverse()).toInt() == 1;
+    }
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    return ok;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("Binary products and reductions", testBinaryReduction());
+    ok &= report("Odd prime reductions", testOddReduction());
+    ok &= report("Greatest common divisors", testGcd());
+    ok &= report("GF(2^163) and GF(2^233) identities", testLargeFields());
+    
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+/*
+ * build_tables.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Command line tool that builds the exp, log and inverse tables
+ * of GF(p^n) for a given modulus and writes them to a table
+ * file, reporting how fast the elements were generated.
+ * 
+ * usage: build_tables [-p prime] [-t threads] modulus output
+ * The modulus is given as its base p number, so 0x11b is the
+ * Rijndael modulus and 0x1100b is x^16 + x^12 + x^3 + x + 1.
+ */
+
+#include "lib/field_tables.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using std::cerr;
+using std::cout;
+
+// Prints how to call the tool and exits
+void usage(){
+    cerr << "usage: build_tables [-p prime] [-t threads] modulus output\n"
+         << "  -p  field characteristic (default 2)\n"
+         << "  -t  threads, 0 for every core (default 0)\n"
+         << "  modulus is the base p number of its coefficients, decimal or 0x hex\n";
+    std::exit(2);
+}
+
+int main(int argc, char ** argv){
+    int p = 2, threads = 0;
+    vector<string> positional;
+    for(int i=1; i<argc; i++){
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(arg == "-p" && hasValue) p = std::atoi(argv[++i]);
+        else if(arg == "-t" && hasValue) threads = std::atoi(argv[++i]);
+        else if(arg.size() > 1 && arg[0] == '-') usage();
+        else positional.push_back(arg);
+    }
+    if(positional.size() != 2 || p < 2) usage();
+    
+    try{
+        // Enough digits for the whole modulus
+        unsigned long value = std::strtoul(positional[0].c_str(), nullptr, 0);
+        int digits = 0;
+        for(unsigned long v=value; v!=0; v/=p) digits++;
+        Polynomial modulus((int) value, p, digits);
+        
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        FieldTables tables(modulus, threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        TableFileWriter writer;
+        addFieldTables(writer, tables);
+        writer.write(positional[1]);
+        
+        cout << "GF(" << tables.prime() << "^" << tables.degree() << "), " << tables.order() << " elements, generator "
+             << tables.generator() << "\nbuilt in " << seconds << " s, " << tables.order() / seconds / 1e6
+             << " M elements/s\n";
+    }
+    catch(const std::exception & e){
+        cerr << "build_tables: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * circulant_mds_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing the circulant mixing layers against general matrix
+ * products, on Rijndael bytes, on GaloisPolynomial states, and
+ * on an 8 by 8 matrix over another field.
+ */
+
+#include "lib/aes.h"
+#include "lib/circulant_mds.h"
+#include "test_util.h"
+#include <iostream>
+#include <random>
+#include <string>
+
+using std::cout;
+using std::string;
+
+// The template's matrices are rijndael_M and, with the factor, rijndael_M_inverse
+bool testMatrices(){
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    QSMatrix<GaloisPolynomial> m = AesMixLayer::matrix<GaloisPolynomial>();
+    QSMatrix<GaloisPolynomial> inverse = AesMixLayer::matrix<GaloisPolynomial>() * AesMixLayerInversePre::matrix<GaloisPolynomial>();
+    bool ok = true;
+    for(int i=0; i<4; i++){
+        for(int j=0; j<4; j++){
+            ok &= m(i, j).toInt() == rijndael_M(i, j).toInt();
+            ok &= inverse(i, j).toInt() == rijndael_M_inverse(i, j).toInt();
+        }
+    }
+    return ok;
+}
+
+// Byte columns match multiplyBytes by the matrix entries, and the inverse undoes them
+bool testBytes(){
+    std::mt19937 rng(45);
+    bool ok = true;
+    for(int trial=0; trial<1000; trial++){
+        unsigned char column[4], original[4], expected[4] = {0};
+        for(int i=0; i<4; i++) column[i] = original[i] = (unsigned char) rng();
+        for(int i=0; i<4; i++){
+            for(int j=0; j<4; j++) expected[i] ^= multiplyBytes((unsigned char) rijndael_M(i, j).toInt(), original[j]);
+        }
+        AesMixLayer::apply(column);
+        for(int i=0; i<4; i++) ok &= column[i] == expected[i];
+        aesMixLayer_inverse(column);
+        for(int i=0; i<4; i++) ok &= column[i] == original[i];
+    }
+    return ok;
+}
+
+// mixColumns and its inverse on polynomial states give the general products
+bool testStates(){
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    std::mt19937 rng(46);
+    bool ok = true;
+    for(int trial=0; trial<50; trial++){
+        vector<GaloisPolynomial> v;
+        for(int i=0; i<16; i++) v.push_back(GaloisPolynomial(rng() % 256));
+        QSMatrix<GaloisPolynomial> state(4, 4, v), forward = rijndael_M * state, backward = rijndael_M_inverse * state;
+        QSMatrix<GaloisPolynomial> mixed(state), unmixed(state);
+        mixColumns(mixed);
+        mixColumns_inverse(unmixed);
+        for(int i=0; i<4; i++){
+            for(int j=0; j<4; j++){
+                ok &= mixed(i, j).toInt() == forward(i, j).toInt();
+                ok &= unmixed(i, j).toInt() == backward(i, j).toInt();
+            }
+        }
+    }
+    return ok;
+}
+
+// The Whirlpool row (01, 01, 04, 01, 08, 05, 02, 09) over x^8 + x^4 + x^3 + x^2 + 1
+bool testOtherField(){
+    typedef CirculantMds<1, 1, 4, 1, 8, 5, 2, 9> Whirlpool;
+    GaloisPolynomial::globalSetModulus(Polynomial(0x11d, 2, 9));
+    std::mt19937 rng(47);
+    QSMatrix<GaloisPolynomial> m = Whirlpool::matrix<GaloisPolynomial>();
+    bool ok = true;
+    for(int trial=0; trial<50; trial++){
+        vector<GaloisPolynomial> column;
+        for(int i=0; i<8; i++) column.push_back(GaloisPolynomial(rng() % 256));
+        vector<GaloisPolynomial> expected = m * column;
+        Whirlpool::apply(column.data());
+        for(int i=0; i<8; i++) ok &= column[i].toInt() == expected[i].toInt();
+    }
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    return ok;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("Circulant matrices match rijndael_M", testMatrices());
+    ok &= report("Byte columns and inverse", testBytes());
+    ok &= report("Polynomial mix columns", testStates());
+    ok &= report("8 by 8 layer over another field", testOtherField());
+    
+    return ok ? 0 : 1;
+}
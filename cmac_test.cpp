@@ -0,0 +1,108 @@
+/*
+ * cmac_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing AES-CMAC against the RFC 4493 and NIST SP 800-38B
+ * examples, and streamed input against whole messages
+ */
+
+#include "lib/cmac.h"
+#include "test_util.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::string;
+using std::vector;
+
+// The example message of both documents, the vectors use its first 0, 16, 40 and 64 bytes
+const string message =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+
+// Checks the tags of the example message prefixes under one key on every engine
+bool testVectors(const string & key, const string tags[4]){
+    vector<unsigned char> k = fromHex(key), m = fromHex(message);
+    AesKey aesKey(k.data(), k.size());
+    size_t lengths[4] = { 0, 16, 40, 64 };
+    
+    bool ok = true;
+    AesEngine engines[2] = { ENGINE_TABLE, ENGINE_HARDWARE };
+    for(int e=0; e<2; e++){
+        Cmac cmac(aesKey, engines[e]);
+        for(int i=0; i<4; i++){
+            vector<unsigned char> expected = fromHex(tags[i]);
+            unsigned char tag[16];
+            cmac.mac(m.data(), lengths[i], tag, 16);
+            if(vector<unsigned char>(tag, tag + 16) != expected) ok = false;
+            if(!cmac.verify(m.data(), lengths[i], expected.data(), 16)) ok = false;
+        }
+    }
+    return ok;
+}
+
+// Streaming random lengths in random pieces gives the same tag as the whole message
+bool testStreaming(){
+    std::mt19937 rng(39);
+    unsigned char key[16];
+    for(int i=0; i<16; i++) key[i] = (unsigned char) rng();
+    Cmac cmac(AesKey(key, 16));
+    CmacStream stream(cmac);
+    
+    bool ok = true;
+    for(int length=0; length<=300; length+=7){
+        vector<unsigned char> m(length);
+        for(int i=0; i<length; i++) m[i] = (unsigned char) rng();
+        unsigned char whole[16], streamed[16];
+        cmac.mac(m.data(), length, whole);
+        
+        int done = 0;
+        while(done < length){
+            int piece = std::min((int) (rng() % 40), length - done);
+            stream.update(m.data() + done, piece);
+            done += piece;
+        }
+        stream.finalize(streamed);
+        if(vector<unsigned char>(whole, whole + 16) != vector<unsigned char>(streamed, streamed + 16)) ok = false;
+    }
+    return ok;
+}
+
+// A changed message or tag fails, a truncated tag still verifies
+bool testVerify(){
+    vector<unsigned char> k = fromHex("2b7e151628aed2a6abf7158809cf4f3c"), m = fromHex(message);
+    Cmac cmac((AesKey(k.data(), 16)));
+    unsigned char tag[16];
+    cmac.mac(m.data(), m.size(), tag);
+    
+    bool ok = cmac.verify(m.data(), m.size(), tag, 8);
+    m[20] ^= 1;
+    ok &= !cmac.verify(m.data(), m.size(), tag);
+    m[20] ^= 1;
+    tag[15] ^= 0x80;
+    ok &= !cmac.verify(m.data(), m.size(), tag);
+    return ok;
+}
+
+int main(){
+    bool ok = true;
+    
+    string tags128[4] = { "bb1d6929e95937287fa37d129b756746", "070a16b46b4d4144f79bdd9dd04a287c",
+                          "dfa66747de9ae63030ca32611497c827", "51f0bebf7e3b9d92fc49741779363cfe" };
+    string tags192[4] = { "d17ddf46adaacde531cac483de7a9367", "9e99a7bf31e710900662f65e617c5184",
+                          "8a1de5be2eb31aad089a82e6ee908b0e", "a1d5df0eed790f794d77589659f39a11" };
+    string tags256[4] = { "028962f61b7bf89efc6b551f4667d983", "28a7023f452e8f82bd4bf28d8c37c35c",
+                          "aaf3d8f1de5640c232f5b169b9c911e6", "e1992190549f6ed5696a2c056c315410" };
+    ok &= report("RFC 4493 AES-128 examples", testVectors("2b7e151628aed2a6abf7158809cf4f3c", tags128));
+    ok &= report("SP 800-38B AES-192 examples", testVectors("8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b", tags192));
+    ok &= report("SP 800-38B AES-256 examples", testVectors(
+        "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4", tags256));
+    ok &= report("Streamed pieces match whole messages", testStreaming());
+    ok &= report("Verify rejects changed messages and tags", testVerify());
+    
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,506 @@
+/*
+ * engine_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Differential testing of every block engine against the
+ * polynomial implementation in lib/aes.cpp. Known answers for
+ * each key length at every round count come first, with the key
+ * schedules and the span and string APIs, then random
+ * (key, block, rounds) triples run through all engines, which
+ * must agree exactly and round trip. The time each engine spent
+ * on the same triples is printed as its throughput.
+ * 
+ * usage: engine_test [triples] [math triples]
+ * The slow polynomial path only checks the first math triples,
+ * the fast engines check each other on the rest.
+ */
+
+#include "lib/aes.h"
+#include "lib/arena.h"
+#include "lib/parallel.h"
+#include "test_util.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::cout;
+using std::string;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+// Engines under test, the polynomial implementation first as the reference
+enum TestEngine{
+    TEST_MATH,
+    TEST_TABLE,
+    TEST_HARDWARE,
+    TEST_ON_THE_FLY,
+    TEST_ENGINES
+};
+
+const char * engineNames[TEST_ENGINES] = { "math", "table", "hardware", "on the fly" };
+
+// One random case
+struct Triple{
+    unsigned char key[32];
+    int keyLength;
+    int rounds;
+    unsigned char block[16];
+};
+
+// Time and results for one engine over the whole run
+struct EngineStats{
+    size_t blocks;
+    size_t mismatches;
+    double setupSeconds;
+    double encryptSeconds;
+    double decryptSeconds;
+};
+
+// Converts bytes to a hex string
+string toHex(const unsigned char * bytes, size_t n){
+    std::ostringstream s;
+    for(size_t i=0; i<n; i++) s << std::hex << std::setw(2) << std::setfill('0') << (int) bytes[i];
+    return s.str();
+}
+
+// Seconds since start
+double elapsed(Clock::time_point start){
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Whether the engine can run on this processor
+bool available(int engine){
+    return engine != TEST_HARDWARE || resolveEngine(ENGINE_HARDWARE) == ENGINE_HARDWARE;
+}
+
+// Encrypts count triples into ciphertexts and decrypts those into plaintexts, timing each step
+void runEngine(int engine, const vector<Triple> & triples, size_t count,
+               unsigned char * ciphertexts, unsigned char * plaintexts, EngineStats & stats){
+    Clock::time_point start = Clock::now();
+    if(engine == TEST_MATH){
+        // Key expansion happens inside every call, so it is counted with the blocks
+        for(size_t t=0; t<count; t++){
+            string key((const char *) triples[t].key, triples[t].keyLength);
+            string block((const char *) triples[t].block, 16);
+            string c = encrypt(block, key, triples[t].rounds);
+            std::copy(c.begin(), c.end(), ciphertexts + 16*t);
+        }
+        stats.encryptSeconds += elapsed(start);
+        
+        start = Clock::now();
+        for(size_t t=0; t<count; t++){
+            string key((const char *) triples[t].key, triples[t].keyLength);
+            string c((const char *) ciphertexts + 16*t, 16);
+            string p = decrypt(c, key, triples[t].rounds);
+            std::copy(p.begin(), p.end(), plaintexts + 16*t);
+        }
+        stats.decryptSeconds += elapsed(start);
+    }
+    else if(engine == TEST_ON_THE_FLY){
+        vector<AesCompactKey> keys;
+        keys.reserve(count);
+        for(size_t t=0; t<count; t++){
+            keys.push_back(AesCompactKey(triples[t].key, triples[t].keyLength, triples[t].rounds));
+        }
+        stats.setupSeconds += elapsed(start);
+        
+        start = Clock::now();
+        for(size_t t=0; t<count; t++) encryptBlocks(keys[t], triples[t].block, ciphertexts + 16*t, 1);
+        stats.encryptSeconds += elapsed(start);
+        
+        start = Clock::now();
+        for(size_t t=0; t<count; t++) decryptBlocks(keys[t], ciphertexts + 16*t, plaintexts + 16*t, 1);
+        stats.decryptSeconds += elapsed(start);
+    }
+    else{
+        AesEngine aesEngine = engine == TEST_TABLE ? ENGINE_TABLE : ENGINE_HARDWARE;
+        vector<AesKey> keys;
+        keys.reserve(count);
+        for(size_t t=0; t<count; t++){
+            keys.push_back(AesKey(triples[t].key, triples[t].keyLength, triples[t].rounds));
+        }
+        stats.setupSeconds += elapsed(start);
+        
+        start = Clock::now();
+        for(size_t t=0; t<count; t++) encryptBlocks(aesEngine, keys[t], triples[t].block, ciphertexts + 16*t, 1);
+        stats.encryptSeconds += elapsed(start);
+        
+        start = Clock::now();
+        for(size_t t=0; t<count; t++) decryptBlocks(aesEngine, keys[t], ciphertexts + 16*t, plaintexts + 16*t, 1);
+        stats.decryptSeconds += elapsed(start);
+    }
+    stats.blocks += count;
+}
+
+// FIPS-197 appendix C key and plaintext at every round count, against an independent implementation
+// The 10, 12 and 14 round answers are the published vectors
+bool testKnownAnswers(){
+    string plaintext = "00112233445566778899aabbccddeeff";
+    string keys[3] = { "000102030405060708090a0b0c0d0e0f",
+                       "000102030405060708090a0b0c0d0e0f1011121314151617",
+                       "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f" };
+    string answers[3][AES_MAX_ROUNDS] = {
+        { "b5f99471dbcf93fe17d6cfa06c61a619", "112cd562f390ce6a66520f457751389f", "8d2656262eb632cc3b3ec75fc430b16c",
+          "6a9a894caa06dd37f05a3061a6fe9f3a", "0a993eb8502aa4cdcfdfa67a69b64f89", "b6e3b9ede3d146f398a2c823ede4c224",
+          "a0a162568be9688d0f93276311bc956a", "795fa5f512e0dacf6dbeea9358a87e47", "0040a2709b25cddd862819921f3de761",
+          "69c4e0d86a7b0430d8cdb78070b4c55a", "bbcd9a21bec7c4ef914464bc47425345", "e8ffaaf01d172248dd0752293170e6a7",
+          "666090f97d0811ce63c7998673fa3c79", "6c3dc1b35a16bc1a32381bdc3b938171" },
+        { "7342f29f1d75f713953645a8e6892419", "d0ab239c42062795317bda7edfb8588e", "5f4c0abdec167229e2c74f662dc0ca6e",
+          "302d59460e1977e91ad14014460fe074", "b94fea97f892c7b1210774de25579ed6", "3855425aaf204dbbe0bdb4b4173a9a59",
+          "60f55f65acd78f3daaa9dde58423833f", "e0dc495b672c89663bfacfe409698b55", "9d125e9808f8ff0e81ff9f88f020ba2b",
+          "56e16826eaf7401d4ddc1e4c3280698f", "1af4a182c19ffd87e9965c41b760b3ef", "dda97ca4864cdfe06eaf70a0ec0d7191",
+          "a7577535ea9036c6ff8fa18f7a9406e0", "8438d3bb9bc0d6d2a1e599a8b15608d3" },
+        { "7342f29f1d75f713d569ad4aa6d7cef8", "21923ff4bb2a50f77636f604d9896cbf", "bbcdd6cc7c1151ffa648ab211a8bd94b",
+          "265ceb0b10716d107576e6391ab660f9", "f111576826581631eca962d781d3b0f5", "e838f852666177ef55afe00bae8ef0bf",
+          "efcd365c4db976fd5f221d06b8c2f975", "fd3cf2a0920f51b113020cd2976a7963", "fb40acc6d84a85955b0027cc21c8dfce",
+          "aa3c2ec11893658550ebe95037725421", "88f8563093b6fc3b86a5a1aa51946687", "eaf5259c6ffc382ddb96b97969ac0456",
+          "9fb72264b3fd70ca8418d9d1b1cbe783", "8ea2b7ca516745bfeafc49904b496089" } };
+    
+    bool ok = true;
+    vector<unsigned char> p = fromHex(plaintext);
+    for(int k=0; k<3; k++){
+        vector<unsigned char> key = fromHex(keys[k]);
+        vector<Triple> triples(AES_MAX_ROUNDS);
+        for(int r=0; r<AES_MAX_ROUNDS; r++){
+            std::copy(key.begin(), key.end(), triples[r].key);
+            triples[r].keyLength = key.size();
+            triples[r].rounds = r + 1;
+            std::copy(p.begin(), p.end(), triples[r].block);
+        }
+        
+        for(int e=0; e<TEST_ENGINES; e++){
+            if(!available(e)) continue;
+            EngineStats stats = {};
+            unsigned char c[16*AES_MAX_ROUNDS], back[16*AES_MAX_ROUNDS];
+            runEngine(e, triples, triples.size(), c, back, stats);
+            for(int r=0; r<AES_MAX_ROUNDS; r++){
+                if(toHex(c + 16*r, 16) != answers[k][r] || toHex(back + 16*r, 16) != plaintext){
+                    cout << "  " << engineNames[e] << " wrong for " << 8*key.size() << " bit key, " << r + 1 << " rounds\n";
+                    ok = false;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+// Checks the FIPS-197 appendix C vectors for every key length through every schedule, and that other lengths throw
+bool testKeySchedules(){
+    string plaintext = "00112233445566778899aabbccddeeff";
+    string keys[3] = { "000102030405060708090a0b0c0d0e0f",
+                       "000102030405060708090a0b0c0d0e0f1011121314151617",
+                       "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f" };
+    string ciphertexts[3] = { "69c4e0d86a7b0430d8cdb78070b4c55a",
+                              "dda97ca4864cdfe06eaf70a0ec0d7191",
+                              "8ea2b7ca516745bfeafc49904b496089" };
+    
+    bool ok = true;
+    for(int k=0; k<3; k++){
+        vector<unsigned char> key = fromHex(keys[k]), p = fromHex(plaintext), c = fromHex(ciphertexts[k]);
+        int rounds = key.size() / 4 + 6;
+        string skey(key.begin(), key.end()), sp(p.begin(), p.end()), sc(c.begin(), c.end());
+        if(encrypt(sp, skey, rounds) != sc || decrypt(sc, skey, rounds) != sp) ok = false;
+        // Leaving out the rounds gives the standard count for the key length
+        if(encrypt(sp, skey) != sc || decrypt(sc, skey) != sp) ok = false;
+        
+        AesKey expanded(key.data(), key.size(), rounds);
+        AesCompactKey compact(key.data(), key.size(), rounds);
+        unsigned char out[16], back[16];
+        AesEngine engines[2] = { ENGINE_TABLE, ENGINE_HARDWARE };
+        for(int e=0; e<2; e++){
+            encryptBlocks(engines[e], expanded, p.data(), out, 1);
+            decryptBlocks(engines[e], expanded, c.data(), back, 1);
+            if(vector<unsigned char>(out, out + 16) != c || vector<unsigned char>(back, back + 16) != p) ok = false;
+        }
+        encryptBlocks(compact, p.data(), out, 1);
+        decryptBlocks(compact, c.data(), back, 1);
+        if(vector<unsigned char>(out, out + 16) != c || vector<unsigned char>(back, back + 16) != p) ok = false;
+        
+        // The span API works in place
+        vector<unsigned char> buffer = p;
+        encrypt(buffer, buffer, expanded);
+        if(buffer != c) ok = false;
+        decrypt(buffer, buffer, expanded);
+        if(buffer != p) ok = false;
+        
+        // The string overload decrypts whole blocks only, a cut ciphertext is refused
+        if(decrypt(sc, expanded) != sp) ok = false;
+        try{
+            decrypt(sc.substr(0, 15), expanded);
+            ok = false;
+        }
+        catch(const runtime_error &){}
+    }
+    
+    // Keys of any other length are refused rather than padded or cut
+    for(size_t length : { (size_t) 0, (size_t) 15, (size_t) 17, (size_t) 20, (size_t) 33 }){
+        try{
+            encrypt(string(16, 'p'), string(length, 'k'));
+            ok = false;
+        }
+        catch(const runtime_error &){}
+    }
+    return ok;
+}
+
+// Checks the table engine against encrypt() and decrypt() from the polynomial implementation
+bool testTableEngine(){
+    std::mt19937 rng(3);
+    bool ok = true;
+    for(int rounds=1; rounds<=10; rounds++){
+        unsigned char key[16], block[16], out[16], roundKeys[16*(AES_MAX_ROUNDS+1)], inverseKeys[16*(AES_MAX_ROUNDS+1)];
+        for(int i=0; i<16; i++) key[i] = (unsigned char) rng();
+        for(int i=0; i<16; i++) block[i] = (unsigned char) rng();
+        
+        expandKeyBytes(key, 16, rounds, roundKeys);
+        encryptBlockTable(roundKeys, rounds, block, out);
+        string expected = encrypt(string((char *) block, 16), string((char *) key, 16), rounds);
+        if(string((char *) out, 16) != expected) ok = false;
+        
+        inverseKeyBytes(roundKeys, rounds, inverseKeys);
+        decryptBlocksTable(inverseKeys, rounds, block, out, 1);
+        expected = decrypt(string((char *) block, 16), string((char *) key, 16), rounds);
+        if(string((char *) out, 16) != expected) ok = false;
+    }
+    return ok;
+}
+
+// Runs random triples through every engine, the math path only on the first mathTriples
+bool testRandomTriples(size_t count, size_t mathTriples, EngineStats * stats){
+    const size_t batch = 4096;
+    std::mt19937 rng(35);
+    int lengths[3] = { 16, 24, 32 };
+    vector<Triple> triples(batch);
+    vector<unsigned char> ciphertexts[TEST_ENGINES], plaintexts[TEST_ENGINES];
+    for(int e=0; e<TEST_ENGINES; e++){
+        ciphertexts[e].resize(16*batch);
+        plaintexts[e].resize(16*batch);
+    }
+    
+    size_t reported = 0;
+    for(size_t done=0; done<count; done+=batch){
+        size_t n = std::min(batch, count - done);
+        for(size_t t=0; t<n; t++){
+            for(int i=0; i<32; i++) triples[t].key[i] = (unsigned char) rng();
+            for(int i=0; i<16; i++) triples[t].block[i] = (unsigned char) rng();
+            triples[t].keyLength = lengths[rng() % 3];
+            triples[t].rounds = 1 + rng() % AES_MAX_ROUNDS;
+        }
+        size_t mathCount = done < mathTriples ? std::min(n, mathTriples - done) : 0;
+        
+        for(int e=0; e<TEST_ENGINES; e++){
+            if(!available(e)) continue;
+            runEngine(e, triples, e == TEST_MATH ? mathCount : n, ciphertexts[e].data(), plaintexts[e].data(), stats[e]);
+        }
+        
+        // The math path is the reference where it ran, the table engine elsewhere
+        for(size_t t=0; t<n; t++){
+            const unsigned char * expected = (t < mathCount ? ciphertexts[TEST_MATH] : ciphertexts[TEST_TABLE]).data() + 16*t;
+            for(int e=0; e<TEST_ENGINES; e++){
+                if(!available(e) || (e == TEST_MATH && t >= mathCount)) continue;
+                if(!std::equal(expected, expected + 16, ciphertexts[e].data() + 16*t) ||
+                   !std::equal(triples[t].block, triples[t].block + 16, plaintexts[e].data() + 16*t)){
+                    stats[e].mismatches++;
+                    if(reported++ < 10){
+                        cout << "  " << engineNames[e] << " mismatch: key " << toHex(triples[t].key, triples[t].keyLength)
+                             << ", rounds " << triples[t].rounds << ", block " << toHex(triples[t].block, 16) << "\n";
+                    }
+                }
+            }
+        }
+    }
+    
+    bool ok = true;
+    for(int e=0; e<TEST_ENGINES; e++){
+        if(stats[e].mismatches != 0) ok = false;
+    }
+    return ok;
+}
+
+// The math path on several threads at once, each with its own arena, matches the table engine
+bool testMathThreads(){
+    std::mt19937 rng(37);
+    vector<Triple> triples(16);
+    for(size_t t=0; t<triples.size(); t++){
+        for(int i=0; i<32; i++) triples[t].key[i] = (unsigned char) rng();
+        for(int i=0; i<16; i++) triples[t].block[i] = (unsigned char) rng();
+        triples[t].keyLength = 16 + 8*(t % 3);
+        triples[t].rounds = 1 + t % AES_MAX_ROUNDS;
+    }
+    
+    vector<unsigned char> expected(16*triples.size()), back(16*triples.size()), c(16*triples.size()), p(16*triples.size());
+    EngineStats stats = {};
+    runEngine(TEST_TABLE, triples, triples.size(), expected.data(), back.data(), stats);
+    parallelFor(triples.size(), 4, [&](size_t begin, size_t end){
+        for(size_t t=begin; t<end; t++){
+            string key((const char *) triples[t].key, triples[t].keyLength);
+            string block((const char *) triples[t].block, 16);
+            string ciphertext = encrypt(block, key, triples[t].rounds);
+            string plaintext = decrypt(ciphertext, key, triples[t].rounds);
+            std::copy(ciphertext.begin(), ciphertext.end(), c.begin() + 16*t);
+            std::copy(plaintext.begin(), plaintext.end(), p.begin() + 16*t);
+        }
+    });
+    return c == expected && std::equal(p.begin(), p.end(), back.begin());
+}
+
+// The math path on a key that puts zero into the S-Box, first here and then on a new thread, matches the table engine
+bool testZeroSBoxInputs(){
+    string keys[2] = { string(16, '\0'), string("0123456789abc\0ef", 16) };
+    string block(16, 'a');
+    bool ok = true;
+    for(int k=0; k<2; k++){
+        unsigned char expected[16];
+        AesKey key((const unsigned char *) keys[k].data(), 16);
+        encryptBlocks(ENGINE_TABLE, key, (const unsigned char *) block.data(), expected, 1);
+        string wanted((const char *) expected, 16), here, there;
+        here = encrypt(block, keys[k]);
+        std::thread([&]{ there = encrypt(block, keys[k]); }).join();
+        ok &= here == wanted && there == wanted && decrypt(wanted, keys[k]) == block;
+    }
+    return ok;
+}
+
+// Polynomials freed on a thread other than the one whose arena or heap they came from
+bool testArenaHandoff(){
+    Polynomial * fromHeap = new Polynomial(0x11b, 2, 9);
+    bool ok = true;
+    {
+        ArenaScope scope;
+        Polynomial * fromArena = new Polynomial(0x11b, 2, 9);
+        *fromArena *= *fromHeap;
+        ok &= fromArena->size() == 17;
+        std::thread([&]{
+            ArenaScope other;
+            delete fromArena;   // Arena memory, left to its arena
+            delete fromHeap;    // Heap memory, freed inside another thread's scope
+        }).join();
+    }
+    return ok;
+}
+
+// Multi key batches on both engines match the table engine one key at a time
+bool testMultiKey(){
+    std::mt19937 rng(40);
+    bool ok = true;
+    int roundCounts[4] = { 1, 7, 0, AES_MAX_ROUNDS };
+    for(int keyLength=16; keyLength<=32; keyLength+=8){
+        for(int r=0; r<4; r++){
+            int rounds = roundCounts[r] ? roundCounts[r] : keyWords(keyLength) + 6;
+            
+            // An odd count so the hardware engine's last group is partial
+            vector<Triple> triples(37);
+            vector<unsigned char> keys, blocks;
+            for(size_t t=0; t<triples.size(); t++){
+                for(int i=0; i<32; i++) triples[t].key[i] = (unsigned char) rng();
+                for(int i=0; i<16; i++) triples[t].block[i] = (unsigned char) rng();
+                triples[t].keyLength = keyLength;
+                triples[t].rounds = rounds;
+                keys.insert(keys.end(), triples[t].key, triples[t].key + keyLength);
+                blocks.insert(blocks.end(), triples[t].block, triples[t].block + 16);
+            }
+            
+            vector<unsigned char> expected(blocks.size()), back(blocks.size()), c(blocks.size());
+            EngineStats stats = {};
+            runEngine(TEST_TABLE, triples, triples.size(), expected.data(), back.data(), stats);
+            
+            AesEngine engines[2] = { ENGINE_TABLE, ENGINE_HARDWARE };
+            for(int e=0; e<2; e++){
+                if(engines[e] == ENGINE_HARDWARE && !available(TEST_HARDWARE)) continue;
+                encryptBlocksMultiKey(engines[e], keys.data(), keyLength, rounds, blocks.data(), c.data(), triples.size());
+                if(c != expected){
+                    cout << "  " << (e ? "hardware" : "table") << " multi key wrong for "
+                         << 8*keyLength << " bit keys, " << rounds << " rounds\n";
+                    ok = false;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+// Runs of 1 to 20 blocks, which the engines split into interleaved groups and a remainder,
+// match the table engine one block at a time, in place or not, at several round counts
+bool testInterleaved(){
+    std::mt19937 rng(41);
+    bool ok = true;
+    int roundCounts[4] = { 1, 7, 10, AES_MAX_ROUNDS };
+    AesEngine engines[2] = { ENGINE_TABLE, ENGINE_HARDWARE };
+    for(int r=0; r<4; r++){
+        unsigned char key[32];
+        for(int i=0; i<32; i++) key[i] = (unsigned char) rng();
+        AesKey expanded(key, 32, roundCounts[r]);
+        for(size_t blocks=1; blocks<=20; blocks++){
+            vector<unsigned char> p(16*blocks), expected(p.size()), c(p.size()), back(p.size());
+            for(size_t i=0; i<p.size(); i++) p[i] = (unsigned char) rng();
+            for(size_t b=0; b<blocks; b++){
+                encryptBlockTable(expanded.encryptionKeys(), roundCounts[r], p.data() + 16*b, expected.data() + 16*b);
+            }
+            for(int e=0; e<2; e++){
+                if(engines[e] == ENGINE_HARDWARE && !available(TEST_HARDWARE)) continue;
+                encryptBlocks(engines[e], expanded, p.data(), c.data(), blocks);
+                decryptBlocks(engines[e], expanded, c.data(), back.data(), blocks);
+                bool match = c == expected && back == p;
+                decryptBlocks(engines[e], expanded, c.data(), c.data(), blocks);
+                match &= c == p;
+                if(!match){
+                    cout << "  " << (e ? "hardware" : "table") << " wrong for " << blocks << " blocks, "
+                         << roundCounts[r] << " rounds\n";
+                    ok = false;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+// Prints the time each engine spent on the random triples
+void printThroughput(const EngineStats * stats){
+    cout << std::left << std::setw(12) << "engine" << std::right << std::setw(10) << "blocks"
+         << std::setw(14) << "setup ns/key" << std::setw(16) << "encrypt ns/blk" << std::setw(16) << "decrypt ns/blk"
+         << std::setw(14) << "encrypt MB/s" << "\n";
+    for(int e=0; e<TEST_ENGINES; e++){
+        const EngineStats & s = stats[e];
+        if(s.blocks == 0) continue;
+        cout << std::left << std::setw(12) << engineNames[e] << std::right << std::setw(10) << s.blocks
+             << std::fixed << std::setprecision(1);
+        if(e == TEST_MATH) cout << std::setw(14) << "-";
+        else cout << std::setw(14) << 1e9*s.setupSeconds/s.blocks;
+        cout << std::setw(16) << 1e9*s.encryptSeconds/s.blocks << std::setw(16) << 1e9*s.decryptSeconds/s.blocks
+             << std::setw(14) << 16*s.blocks/s.encryptSeconds/1e6 << "\n";
+    }
+}
+
+int main(int argc, char ** argv){
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t mathTriples = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+    bool ok = true;
+    
+    ok &= report("Known answers at every round count", testKnownAnswers());
+    ok &= report("FIPS-197 vectors for 128, 192 and 256 bit keys, other lengths refused", testKeySchedules());
+    ok &= report("Table engine matches encrypt() and decrypt()", testTableEngine());
+    
+    ok &= report("Math path on several threads", testMathThreads());
+    ok &= report("Zero S-Box inputs on a new thread", testZeroSBoxInputs());
+    ok &= report("Polynomials freed on another thread", testArenaHandoff());
+    
+    ok &= report("Multi key batches match single keys", testMultiKey());
+    
+    ok &= report("Interleaved runs match single blocks", testInterleaved());
+    
+    EngineStats stats[TEST_ENGINES] = {};
+    ok &= report("Engines agree on " + std::to_string(count) + " random triples", testRandomTriples(count, mathTriples, stats));
+    if(!available(TEST_HARDWARE)) cout << "hardware engine not available, skipped\n";
+    printThroughput(stats);
+    
+    return ok ? 0 : 1;
+}
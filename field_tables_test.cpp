@@ -0,0 +1,101 @@
+/*
+ * field_tables_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing field tables against GaloisPolynomial for GF(2^8),
+ * against field identities for GF(2^16), GF(3^5) and GF(65537), and
+ * through a table file round trip.
+ */
+
+#include "lib/aes.h"
+#include "lib/field_tables.h"
+#include "test_util.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using std::cout;
+using std::string;
+
+// Every inverse in the Rijndael field matches the extended Euclid of GaloisPolynomial
+bool testRijndael(){
+    FieldTables tables(rijndael_Mod, 4);
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    bool ok = tables.order() == 256 && tables.generator() == 3;
+    for(int a=1; a<256 && ok; a++){
+        ok &= tables.inverse(a) == (uint32_t) GaloisPolynomial(a).inverse().toInt();
+        ok &= tables.exp(tables.log(a)) == (uint32_t) a;
+    }
+    for(int a=0; a<256 && ok; a+=7){
+        for(int b=0; b<256; b+=5){
+            ok &= tables.multiply(a, b) == (uint32_t) (GaloisPolynomial(a) * GaloisPolynomial(b)).toInt();
+        }
+    }
+    return ok && tables.inverse(0) == 0;
+}
+
+// Every exp is distinct, a * a^-1 = 1, and a thread count does not change the tables
+bool testIdentities(const Polynomial & modulus){
+    FieldTables tables(modulus, 4), serial(modulus, 1);
+    ConstByteSpan a = tables.bytes(), b = serial.bytes();
+    bool ok = a.size == b.size && std::equal(a.data, a.data + a.size, b.data);
+    
+    vector<bool> seen(tables.order(), false);
+    for(uint32_t i=0; i+1<tables.order() && ok; i++){
+        uint32_t x = tables.exp(i);
+        ok &= x != 0 && x < tables.order() && !seen[x];
+        seen[x] = true;
+        ok &= tables.multiply(x, tables.inverse(x)) == 1;
+    }
+    return ok;
+}
+
+// Tables read back from a table file match the built ones
+bool testTableFile(){
+    const string path = "field_tables_test.tmp";
+    FieldTables tables(rijndael_Mod);
+    TableFileWriter writer;
+    addFieldTables(writer, tables);
+    writer.write(path);
+    
+    bool ok;
+    {
+        TableFile file(path);
+        long i = file.find(SECTION_FIELD_TABLES);
+        ok = i >= 0;
+        if(ok){
+            FieldTables mapped(file.section(i));
+            ok = mapped.order() == 256 && mapped.generator() == tables.generator();
+            for(uint32_t a=0; a<256; a++) ok &= mapped.inverse(a) == tables.inverse(a);
+        }
+    }
+    std::remove(path.c_str());
+    return ok;
+}
+
+// A reducible modulus has no generator
+bool testReducible(){
+    try{
+        FieldTables tables(Polynomial(0x11a, 2, 9));
+    }
+    catch(const runtime_error &){
+        return true;
+    }
+    return false;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("GF(2^8) tables match GaloisPolynomial", testRijndael());
+    ok &= report("GF(2^16) field identities", testIdentities(Polynomial(0x1100b, 2, 17)));
+    // x^5 + 2x + 1 over GF(3), numbered 243 + 2*3 + 1
+    ok &= report("GF(3^5) field identities", testIdentities(Polynomial(250, 3, 6)));
+    // 2x + 5 over GF(65537), whose products overflow 32 bits and whose lead needs an inverse
+    ok &= report("GF(65537) field identities", testIdentities(Polynomial(vector<Modular<int>>{ 5, 2 }, 65537)));
+    ok &= report("Tables read back from a table file", testTableFile());
+    ok &= report("Reducible modulus refused", testReducible());
+    
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+/*
+ * gcm_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing GHASH against polynomial multiplication in
+ * GF(2^128) and AES-GCM against the NIST test vectors
+ */
+ 
+#include "lib/aes.h"
+#include "lib/aes_tables.h"
+#include "lib/gcm.h"
+#include "test_util.h"
+#include <iostream>
+#include <random>
+
+using std::cout;
+
+// Converts a GCM block to a polynomial, bit i of the block is the coefficient of x^i
+GaloisPolynomial blockToPoly(const unsigned char * block){
+    vector<Modular<int>> coef;
+    for(int i=0; i<128; i++){
+        coef.push_back((block[i/8] >> (7 - i%8)) & 1);
+    }
+    return GaloisPolynomial(coef);
+}
+
+// Converts a polynomial back to a GCM block
+void polyToBlock(const GaloisPolynomial & p, unsigned char * block){
+    for(int i=0; i<16; i++) block[i] = 0;
+    for(int i=0; i<p.size(); i++){
+        if(p[i].value() != 0) block[i/8] |= (unsigned char) (0x80 >> (i%8));
+    }
+}
+
+// Checks x*H from every GHASH method against the polynomial product mod gcm_Mod
+bool testGhashOracle(){
+    std::mt19937 rng(2015);
+    GaloisPolynomial::globalSetModulus(gcm_Mod);
+    
+    bool ok = true;
+    GhashMethod methods[3] = { GHASH_TABLE4, GHASH_TABLE8, GHASH_CLMUL };
+    for(int trial=0; trial<16; trial++){
+        unsigned char h[16], x[64];
+        for(int i=0; i<16; i++) h[i] = (unsigned char) rng();
+        for(int i=0; i<64; i++) x[i] = (unsigned char) rng();
+        
+        // Four blocks exercise the aggregated reduction: y = (((x1 H + x2) H + x3) H + x4) H
+        GaloisPolynomial hp = blockToPoly(h);
+        GaloisPolynomial yp(0, 2, 1);
+        for(int b=0; b<4; b++){
+            yp = (yp + blockToPoly(x + 16*b)) * hp;
+        }
+        unsigned char expected[16];
+        polyToBlock(yp, expected);
+        
+        for(int m=0; m<3; m++){
+            Ghash ghash(h, methods[m]);
+            unsigned char y[16] = {0};
+            ghash.update(y, x, 4);
+            for(int i=0; i<16; i++){
+                if(y[i] != expected[i]) ok = false;
+            }
+        }
+    }
+    
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    return ok;
+}
+
+// Runs one NIST vector with every GHASH method
+bool testGcmVector(const string & key, const string & iv, const string & aad,
+                   const string & plaintext, const string & ciphertext, const string & tag){
+    vector<unsigned char> k = fromHex(key), n = fromHex(iv), a = fromHex(aad);
+    vector<unsigned char> p = fromHex(plaintext), c = fromHex(ciphertext), t = fromHex(tag);
+    
+    bool ok = true;
+    GhashMethod methods[3] = { GHASH_TABLE4, GHASH_TABLE8, GHASH_CLMUL };
+    for(int m=0; m<3; m++){
+        Gcm gcm(AesKey(k.data(), k.size()), methods[m]);
+        vector<unsigned char> out(p.size() + 1), outTag(16), back(p.size() + 1);
+        gcm.encrypt(n.data(), n.size(), a.data(), a.size(), p.data(), out.data(), p.size(), outTag.data());
+        out.resize(p.size());
+        if(out != c || outTag != t) ok = false;
+        
+        if(!gcm.decrypt(n.data(), n.size(), a.data(), a.size(), c.data(), back.data(), c.size(), t.data())) ok = false;
+        back.resize(p.size());
+        if(back != p) ok = false;
+        
+        // A flipped tag bit must be rejected
+        outTag[0] ^= 1;
+        if(gcm.decrypt(n.data(), n.size(), a.data(), a.size(), c.data(), back.data(), c.size(), outTag.data())) ok = false;
+    }
+    return ok;
+}
+
+// Building the tables leaves the caller's field and prime in place
+bool testTablesKeepModulus(){
+    GaloisPolynomial::globalSetModulus(gcm_Mod);
+    Modular<int>::globalSetModulus(3);
+    AesTables t = buildAesTables();
+    bool ok = t.sbox[0] == 0x63 && Modular<int>::globalModulus() == 3;
+    Modular<int>::globalSetModulus(2);
+    ok &= GaloisPolynomial::globalModulus().toString() == gcm_Mod.toString();
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    return ok;
+}
+
+// Encrypts random messages in place with every method and checks they agree and round trip
+bool testGcmLengths(){
+    std::mt19937 rng(7);
+    unsigned char key[16], iv[12], aad[20];
+    for(int i=0; i<16; i++) key[i] = (unsigned char) rng();
+    for(int i=0; i<12; i++) iv[i] = (unsigned char) rng();
+    for(int i=0; i<20; i++) aad[i] = (unsigned char) rng();
+    AesKey aesKey(key, 16);
+    Gcm gcm4(aesKey, GHASH_TABLE4), gcm8(aesKey, GHASH_TABLE8), gcmc(aesKey, GHASH_CLMUL);
+    
+    bool ok = true;
+    for(int length=0; length<=300; length+=13){
+        vector<unsigned char> p(length), c4, c8, cc;
+        for(int i=0; i<length; i++) p[i] = (unsigned char) rng();
+        unsigned char t4[16], t8[16], tc[16];
+        c4 = p; c8 = p; cc = p;
+        gcm4.encrypt(iv, 12, aad, 20, c4.data(), c4.data(), length, t4);
+        gcm8.encrypt(iv, 12, aad, 20, c8.data(), c8.data(), length, t8);
+        gcmc.encrypt(iv, 12, aad, 20, cc.data(), cc.data(), length, tc);
+        if(c4 != c8 || c4 != cc) ok = false;
+        for(int i=0; i<16; i++){
+            if(t4[i] != t8[i] || t4[i] != tc[i]) ok = false;
+        }
+        if(!gcmc.decrypt(iv, 12, aad, 20, cc.data(), cc.data(), length, tc) || cc != p) ok = false;
+    }
+    return ok;
+}
+
+// Messages past 2^32 - 2 blocks are refused before anything is written, as are tags SP 800-38D does not allow
+bool testGcmLimits(){
+    unsigned char k[16] = {0}, iv[12] = {0}, block[16] = {0}, tag[16];
+    Gcm gcm(AesKey(k, 16));
+    bool ok = true;
+    try{
+        gcm.encrypt(iv, 12, nullptr, 0, nullptr, nullptr, GCM_MAX_LENGTH + 1, tag);
+        ok = false;
+    }
+    catch(const runtime_error &){}
+    
+    // Tag lengths SP 800-38D does not allow
+    size_t badTags[] = { 0, 3, 5, 6, 7, 9, 10, 11, 17 };
+    for(size_t tagLength : badTags){
+        try{
+            gcm.encrypt(iv, 12, nullptr, 0, block, block, 16, tag, tagLength);
+            ok = false;
+        }
+        catch(const runtime_error &){}
+        try{
+            gcm.decrypt(iv, 12, nullptr, 0, block, block, 16, tag, tagLength);
+            ok = false;
+        }
+        catch(const runtime_error &){}
+    }
+    size_t goodTags[] = { 4, 8, 12, 13, 14, 15, 16 };
+    for(size_t tagLength : goodTags){
+        gcm.encrypt(iv, 12, nullptr, 0, block, block, 16, tag, tagLength);
+        ok &= gcm.decrypt(iv, 12, nullptr, 0, block, block, 16, tag, tagLength);
+    }
+    
+    GcmStream stream(gcm, true, iv, 12);
+    stream.update(block, 16, block);
+    try{
+        stream.update(nullptr, GCM_MAX_LENGTH - 15, nullptr);
+        ok = false;
+    }
+    catch(const runtime_error &){}
+    return ok;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("GHASH matches GaloisPolynomial multiplication", testGhashOracle());
+    ok &= report("Building the tables keeps the caller's moduli", testTablesKeepModulus());
+    ok &= report("GHASH methods agree for in place messages", testGcmLengths());
+    ok &= report("Overlong messages and bad tag lengths are refused", testGcmLimits());
+    
+    ok &= report("GCM test case 1", testGcmVector(
+        "00000000000000000000000000000000", "000000000000000000000000", "", "", "",
+        "58e2fccefa7e3061367f1d57a4e7455a"));
+    ok &= report("GCM test case 2", testGcmVector(
+        "00000000000000000000000000000000", "000000000000000000000000", "",
+        "00000000000000000000000000000000", "0388dace60b6a392f328c2b971b2fe78",
+        "ab6e47d42cec13bdf53a67b21257bddf"));
+    ok &= report("GCM test case 3", testGcmVector(
+        "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", "",
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+        "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+        "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+        "4d5c2af327cd64a62cf35abd2ba6fab4"));
+    ok &= report("GCM test case 4", testGcmVector(
+        "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+        "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+        "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+        "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+        "5bc94fbc3221a5db94fae95ae7121a47"));
+    ok &= report("GCM test case 5", testGcmVector(
+        "feffe9928665731c6d6a8f9467308308", "cafebabefacedbad",
+        "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+        "61353b4c2806934a777ff51fa22a4755699b2a714fcdc6f83766e5f97b6c7423"
+        "73806900e49f24b22b097544d4896b424989b5e1ebac0f07c23f4598",
+        "3612d2e79e3b0785561be14aaca2fccb"));
+    ok &= report("GCM test case 6", testGcmVector(
+        "feffe9928665731c6d6a8f9467308308",
+        "9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728"
+        "c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b",
+        "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+        "8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca7"
+        "01e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5",
+        "619cc5aefffe0bfa462af43c1699d050"));
+    ok &= report("GCM test case 10", testGcmVector(
+        "feffe9928665731c6d6a8f9467308308feffe9928665731c", "cafebabefacedbaddecaf888",
+        "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+        "3980ca0b3c00e841eb06fac4872a2757859e1ceaa6efd984628593b40ca1e19c"
+        "7d773d00c144c525ac619d18c84a3f4718e2448b2fe324d9ccda2710",
+        "2519498e80f1478f37ba55bd6d27618c"));
+    ok &= report("GCM test case 16", testGcmVector(
+        "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+        "cafebabefacedbaddecaf888", "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+        "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+        "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+        "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+        "76fc6ece0f4e1768cddf8853bb2d551b"));
+    
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+/*
+ * integral_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing the integral property through three rounds, its loss
+ * at four, and key recovery from a four round oracle by the
+ * square attack.
+ */
+
+#include "lib/aes_engine.h"
+#include "lib/integral.h"
+#include "test_util.h"
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+using std::cout;
+using std::string;
+
+// One to three rounds keep every output byte balanced, on both engines and any thread count
+bool testBalanced(){
+    bool ok = true;
+    for(int rounds=1; rounds<=3; rounds++){
+        IntegralResult table = integralTest(rounds, 64, 1, ENGINE_TABLE);
+        IntegralResult best = integralTest(rounds, 64, 3);
+        ok &= table.balancedSets == 64 && best.balancedSets == 64 && best.balancedBytes == 64*16;
+        ok &= table.encryptions == 64*LAMBDA_SET_SIZE;
+    }
+    return ok;
+}
+
+// At four rounds bytes balance only by chance, one in 256 of them
+bool testFourRounds(){
+    IntegralResult result = integralTest(4, 256, 0);
+    return result.balancedSets == 0 && result.balancedBytes < 64;
+}
+
+// Lambda sets hold every value of the active byte and nothing else changes, so all of it is balanced
+bool testLambdaSet(){
+    unsigned char base[16], set[16*LAMBDA_SET_SIZE];
+    for(int i=0; i<16; i++) base[i] = (unsigned char) (i * 17);
+    lambdaSet(base, 5, set);
+    bool ok = balancedBytes(set) == 0xffff;
+    for(int v=0; v<LAMBDA_SET_SIZE; v++){
+        ok &= set[16*v + 5] == v && memcmp(set + 16*v, base, 5) == 0;
+    }
+    return ok;
+}
+
+// The last round key walks back to the cipher key for every key length
+bool testFirstKeyBytes(){
+    std::mt19937 rng(44);
+    bool ok = true;
+    for(int length=16; length<=32; length+=8){
+        for(int rounds=2; rounds<=14; rounds++){
+            unsigned char key[32], last[32], back[32];
+            for(int i=0; i<length; i++) key[i] = (unsigned char) rng();
+            lastKeyBytes(key, length, rounds, last);
+            firstKeyBytes(last, length, rounds, back);
+            ok &= memcmp(key, back, length) == 0;
+        }
+    }
+    return ok;
+}
+
+// The square attack recovers random keys behind a four round oracle
+bool testSquareAttack(){
+    std::mt19937 rng(4);
+    bool ok = true;
+    for(int trial=0; trial<3; trial++){
+        unsigned char key[16];
+        for(int i=0; i<16; i++) key[i] = (unsigned char) rng();
+        AesKey secret(key, 16, 4);
+        EncryptionOracle oracle = [&](const unsigned char * in, unsigned char * out, size_t blocks){
+            encryptBlocks(ENGINE_AUTO, secret, in, out, blocks);
+        };
+        
+        SquareAttackResult result = squareAttack(oracle, trial + 1);
+        ok &= result.found && memcmp(result.key, key, 16) == 0 && result.lambdaSets <= 16;
+    }
+    return ok;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("Lambda set construction", testLambdaSet());
+    ok &= report("Balanced through three rounds", testBalanced());
+    ok &= report("Unbalanced after four rounds", testFourRounds());
+    ok &= report("Cipher key from last round key", testFirstKeyBytes());
+    ok &= report("Four round square attack", testSquareAttack());
+    
+    return ok ? 0 : 1;
+}
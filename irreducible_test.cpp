@@ -0,0 +1,91 @@
+/*
+ * irreducible_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing the irreducibility and primitivity tests on known
+ * moduli, the enumerators against Gauss's counts, and the sparse
+ * search against the moduli of the NIST binary curves.
+ */
+
+#include "lib/aes.h"
+#include "lib/gcm.h"
+#include "lib/irreducible.h"
+#include "test_util.h"
+#include <iostream>
+#include <string>
+
+using std::cout;
+using std::string;
+
+// rijndael_Mod is irreducible but x only has order 51, x^8 + x^4 + x^3 + x^2 + 1 is primitive
+bool testKnownModuli(){
+    Polynomial whirlpool(0x11d, 2, 9), reducible(0x11f, 2, 9);
+    return isIrreducible(rijndael_Mod) && isIrreducibleBenOr(rijndael_Mod) && !isPrimitive(rijndael_Mod)
+        && isPrimitive(whirlpool) && !isIrreducible(reducible) && !isIrreducibleBenOr(reducible)
+        && isIrreducible(gcm_Mod) && isIrreducibleBenOr(gcm_Mod);
+}
+
+// Enumerated counts match Gauss's formula and phi(p^n - 1) / n, whatever the thread count
+bool testCounts(){
+    bool ok = true;
+    int fields[][2] = { {2, 1}, {2, 8}, {2, 12}, {3, 1}, {3, 5}, {5, 4}, {7, 3} };
+    for(auto & field : fields){
+        int p = field[0], n = field[1];
+        vector<Polynomial> all = irreduciblePolynomials(p, n, 3);
+        vector<Polynomial> primitive = primitivePolynomials(p, n, 2);
+        ok &= all.size() == countIrreducible(p, n) && primitive.size() == countPrimitive(p, n);
+        ok &= irreduciblePolynomials(p, n, 1).size() == all.size();
+        for(size_t i=1; i<all.size(); i++) ok &= all[i-1].toInt() < all[i].toInt();
+    }
+    ok &= countIrreducible(2, 8) == 30 && countPrimitive(2, 8) == 16;
+    return ok;
+}
+
+// Rabin and Ben-Or agree on every monic polynomial of degree 10 over GF(2) and degree 4 over GF(3)
+bool testAgreement(){
+    bool ok = true;
+    for(int v=1024; v<2048; v++){
+        Polynomial f(v, 2, 11);
+        ok &= isIrreducible(f) == isIrreducibleBenOr(f);
+    }
+    for(int v=81; v<162; v++){
+        Polynomial f(v, 3, 5);
+        ok &= isIrreducible(f) == isIrreducibleBenOr(f);
+    }
+    return ok;
+}
+
+// Products of irreducible polynomials are reducible
+bool testProducts(){
+    vector<Polynomial> small = irreduciblePolynomials(2, 5);
+    bool ok = true;
+    for(size_t i=0; i<small.size(); i++){
+        Polynomial square = small[i] * small[i], product = small[i] * small[(i + 1) % small.size()];
+        ok &= !isIrreducible(square) && !isIrreducibleBenOr(square) && !isIrreducible(product);
+    }
+    return ok;
+}
+
+// The sparse search finds the moduli of the NIST binary fields
+bool testSparse(){
+    vector<Modular<int>> b163(164, 0), b233(234, 0);
+    b163[163] = b163[7] = b163[6] = b163[3] = b163[0] = 1;
+    b233[233] = b233[74] = b233[0] = 1;
+    Polynomial found163 = sparseIrreducible(2, 163), found233 = sparseIrreducible(2, 233);
+    Polynomial expected163(b163), expected233(b233);
+    return found163.toString() == expected163.toString() && found233.toString() == expected233.toString()
+        && isIrreducible(found233) && sparseIrreducible(2, 8, true).toInt() == 0x11d;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("Known moduli", testKnownModuli());
+    ok &= report("Enumerated counts", testCounts());
+    ok &= report("Rabin and Ben-Or agree", testAgreement());
+    ok &= report("Products are reducible", testProducts());
+    ok &= report("Sparse NIST moduli", testSparse());
+    
+    return ok ? 0 : 1;
+}
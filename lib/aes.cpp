@@ -11,10 +11,11 @@
 #define AES_CPP
 
 #include "aes.h"
+#include "circulant_mds.h"
 
 // Mod polynomial used in Rijndael field
 const Polynomial rijndael_Mod(vector<Modular<int>>{
-    1, 0, 0, 0, 1, 1, 0, 1, 1
+    1, 1, 0, 1, 1, 0, 0, 0, 1
 });
 
 // Affine transformation A for S-Box
@@ -65,36 +66,49 @@ const QSMatrix<GaloisPolynomial> rijndael_M_inverse(4, 4, vector<GaloisPolynomia
 
 // Perform p = A * p^(-1) + b
 GaloisPolynomial & sBox(GaloisPolynomial & p){
+    return sBox(p, rijndael_A, rijndael_b);
+}
+
+// Perform p = A * p^(-1) + b for another affine map, A is n by n for a field of degree n
+GaloisPolynomial & sBox(GaloisPolynomial & p, const vector<Modular<int>> & A, const GaloisPolynomial & b){
+    int n = (int) std::sqrt((double) A.size());
+    if(n*n != (int) A.size()) throw runtime_error("Affine map must be square.");
+    
+    // The affine map is over the field's prime, set here since inverting zero never touches it
+    Modular<int>::globalSetModulus(GaloisPolynomial::globalModulus().getPrime());
+    
     // Invert each element
     p = p.inverse();
     
     // Calculate affine transformation
     vector<Modular<int>> coef;
-    for(int r=0; r<8; r++){
-        Modular<int> sum(0);
-        for(int c=0; c<8; c++){
-            sum += p[c] * rijndael_A[r*8+c];
+    for(int r=0; r<n; r++){
+        ProductSum<Modular<int>> sum;
+        for(int c=0; c<n; c++){
+            sum.add(p[c], A[r*n+c]);
         }
-        coef.push_back(sum);
+        coef.push_back(sum.result());
     }
     p = GaloisPolynomial(coef);
     
     // Add polynomial b
-    p += rijndael_b;
+    p += b;
     
     return p;
 }
 
 // Perform p = (A_inverse * p + b_inverse)^(-1) (inverse S-Box)
 GaloisPolynomial & sBox_inverse(GaloisPolynomial & p){
+    Modular<int>::globalSetModulus(GaloisPolynomial::globalModulus().getPrime());
+    
     // Calculate affine transformation
     vector<Modular<int>> coef;
     for(int r=0; r<8; r++){
-        Modular<int> sum(0);
+        ProductSum<Modular<int>> sum;
         for(int c=0; c<8; c++){
-            sum += p[c] * rijndael_A_inverse[r*8+c];
+            sum.add(p[c], rijndael_A_inverse[r*8+c]);
         }
-        coef.push_back(sum);
+        coef.push_back(sum.result());
     }
     p = GaloisPolynomial(coef);
     
@@ -109,6 +123,7 @@ GaloisPolynomial & sBox_inverse(GaloisPolynomial & p){
 
 // Perform s(i,j) = A * s(i,j)^(-1) + b for all 0<=i,j<=3
 QSMatrix<GaloisPolynomial> & subBytes(QSMatrix<GaloisPolynomial> & state){
+    INSTRUMENT_STAGE(STAGE_SUB_BYTES);
     Modular<int>::globalSetModulus(2);
     for(int i=0; i<state.getRows(); i++){
         for(int j=0; j<state.getCols(); j++){
@@ -121,6 +136,7 @@ QSMatrix<GaloisPolynomial> & subBytes(QSMatrix<GaloisPolynomial> & state){
 
 // Perform s(i,j) = (A_inverse * p + b_inverse)^(-1) (inverse S-Box) for all 0<=i,j<=3
 QSMatrix<GaloisPolynomial> & subBytes_inverse(QSMatrix<GaloisPolynomial> & state){
+    INSTRUMENT_STAGE(STAGE_SUB_BYTES);
     Modular<int>::globalSetModulus(2);
     for(int i=0; i<state.getRows(); i++){
         for(int j=0; j<state.getCols(); j++){
@@ -131,8 +147,9 @@ QSMatrix<GaloisPolynomial> & subBytes_inverse(QSMatrix<GaloisPolynomial> & state
     return state;
 }
 
-// Rotate each row right by its index
+// Rotate each row left by its index
 QSMatrix<GaloisPolynomial> & shiftRows(QSMatrix<GaloisPolynomial> & state){
+    INSTRUMENT_STAGE(STAGE_SHIFT_ROWS);
     for(int i=0; i<state.getRows(); i++){
         vector<GaloisPolynomial> temp;  // Save first as temp since it is overwritten
         for(int j=0; j<state.getCols(); j++){
@@ -147,8 +164,9 @@ QSMatrix<GaloisPolynomial> & shiftRows(QSMatrix<GaloisPolynomial> & state){
     return state;
 }
 
-// Rotate each row left by its index
+// Rotate each row right by its index
 QSMatrix<GaloisPolynomial> & shiftRows_inverse(QSMatrix<GaloisPolynomial> & state){
+    INSTRUMENT_STAGE(STAGE_SHIFT_ROWS);
     for(int i=0; i<state.getRows(); i++){
         vector<GaloisPolynomial> temp;  // Save first as temp since it is overwritten
         for(int j=0; j<state.getCols(); j++){
@@ -164,22 +182,26 @@ QSMatrix<GaloisPolynomial> & shiftRows_inverse(QSMatrix<GaloisPolynomial> & stat
     return state;
 }
 
-// Performs state = M * state
+// Performs state = M * state, through x multiplies shared by each column instead of a general product
 QSMatrix<GaloisPolynomial> & mixColumns(QSMatrix<GaloisPolynomial> & state){
-    state = rijndael_M * state;
+    INSTRUMENT_STAGE(STAGE_MIX_COLUMNS);
+    AesMixLayer::apply(state);
     
     return state;
 }
 
-// Performs state = M_inverse * state
+// Performs state = M_inverse * state as M * (05, 00, 04, 00) * state
 QSMatrix<GaloisPolynomial> & mixColumns_inverse(QSMatrix<GaloisPolynomial> & state){
-    state = rijndael_M_inverse * state;
+    INSTRUMENT_STAGE(STAGE_MIX_COLUMNS);
+    AesMixLayerInversePre::apply(state);
+    AesMixLayer::apply(state);
     
     return state;
 }
 
 // Adds portion of the key into the computation
 QSMatrix<GaloisPolynomial> & addRoundKey(QSMatrix<GaloisPolynomial> & state, const QSMatrix<GaloisPolynomial> & key){
+    INSTRUMENT_STAGE(STAGE_ADD_ROUND_KEY);
     state += key;
     
     return state;
@@ -212,9 +234,9 @@ vector<GaloisPolynomial>& keyExpandCore(vector<GaloisPolynomial> & word, int ite
         sBox(word[i]);
     }
     
-    // Apply Rcon operation (add 2^(iteration-1) to word[0])
+    // Apply Rcon operation (add x^(iteration-1) to word[0])
     vector<Modular<int>> v;
-    for(int i=0; i<iteration-2; i++){
+    for(int i=0; i<iteration-1; i++){
         v.push_back(0);
     }
     v.push_back(1);
@@ -223,43 +245,55 @@ vector<GaloisPolynomial>& keyExpandCore(vector<GaloisPolynomial> & word, int ite
     return word;
 }
 
-// Takes 16 byte (128 bit) key and returns rounds + 1 16 byte keys in matrix form
+// Takes a 16, 24 or 32 byte key and returns rounds + 1 16 byte keys in matrix form
 vector<QSMatrix<GaloisPolynomial>> expandKey(vector<unsigned char> key, int rounds){
+    return expandKey(ConstByteSpan(key), rounds);
+}
+
+// Takes a 16, 24 or 32 byte key and returns rounds + 1 16 byte keys in matrix form
+// Any other length throws
+vector<QSMatrix<GaloisPolynomial>> expandKey(ConstByteSpan key, int rounds){
+    INSTRUMENT_STAGE(STAGE_EXPAND_KEY);
+    // Number of words in the key (Nk)
+    int nk = keyWords((int) key.size);
+    
     vector<GaloisPolynomial> keyBytes;
-    keyBytes.reserve(16*(rounds+1));    // Reserve space so inserts are faster
+    keyBytes.reserve(16*(rounds+1) + 4*nk);    // Reserve space so inserts are faster
     
-    // Just copy in key for first 16 bytes
-    for(int i=0; i<16; i++){
-        keyBytes.push_back(extractPoly(key));
+    // Just copy in key for first nk words
+    for(int i=0; i<4*nk; i++){
+        keyBytes.push_back(GaloisPolynomial(key.data[i]));
     }
     
-    int iteration = 1;
-    
     // Continue until we have a 128 bit key for each round + an initial key
-    while(keyBytes.size()<16*(rounds+1)){
-        for(int w=0; w<4; w++){
-            // Copy last 4 bytes
-            vector<GaloisPolynomial> word;
-            for(int i=0; i<4; i++){
-                word.push_back(keyBytes[keyBytes.size()-5+i]);
-            }
-            
-            // Apply core operations if first word
-            if(w==0) keyExpandCore(word, iteration);
-            
-            // Add each byte with that 16 bytes back
+    for(int w=nk; w<4*(rounds+1); w++){
+        // Copy last 4 bytes
+        vector<GaloisPolynomial> word;
+        for(int i=0; i<4; i++){
+            word.push_back(keyBytes[4*(w-1)+i]);
+        }
+        
+        // Apply core operations to the first word of each key length,
+        // 256 bit keys also substitute the word halfway through
+        if(w % nk == 0){
+            keyExpandCore(word, w / nk);
+        }
+        else if(nk > 6 && w % nk == 4){
             for(int i=0; i<4; i++){
-                word[i] += keyBytes[keyBytes.size()-16+i];
+                sBox(word[i]);
             }
-            
-            // Append
-            keyBytes.insert(keyBytes.end(), word.begin(), word.end());
         }
         
-        iteration += 1;
+        // Add each byte with the word one key length back
+        for(int i=0; i<4; i++){
+            word[i] += keyBytes[4*(w-nk)+i];
+        }
+        
+        // Append
+        keyBytes.insert(keyBytes.end(), word.begin(), word.end());
     }
     
-    // Convert to vector of matrices
+    // Convert to vector of matrices, each word of the key is a column
     vector<QSMatrix<GaloisPolynomial>> keyMatrices;
     
     for(int i=0; i<rounds+1; i++){
@@ -267,33 +301,48 @@ vector<QSMatrix<GaloisPolynomial>> expandKey(vector<unsigned char> key, int roun
         for(int b=0; b<16; b++){
             v.push_back(keyBytes[i*16+b]);
         }
-        keyMatrices.push_back(QSMatrix<GaloisPolynomial>(4, 4, v));
+        keyMatrices.push_back(QSMatrix<GaloisPolynomial>(4, 4, v).transpose());
     }
     
     return keyMatrices;
 }
 
-// Does rounds of AES encryption on plaintext with key
-string encrypt(string plaintext, string key, int rounds){
-    // Set up Galois Field
-    GaloisPolynomial::globalSetModulus(rijndael_Mod);
-    
-    // Convert strings to unsigned characters
-    vector<unsigned char> vplaintext(plaintext.begin(), plaintext.end());
-    vector<unsigned char> vkey(key.begin(), key.end());
-    
-    // Expand key
-    vector<QSMatrix<GaloisPolynomial>> keyMatrices = expandKey(vkey, rounds);
-    
-    // Convert plaintext to matrix representation
+// Reverses the round keys and applies inverse mix columns to all but the first and last,
+// since inverse mix columns is linear it can act on the key once instead of every round
+vector<QSMatrix<GaloisPolynomial>> inverseKeySchedule(const vector<QSMatrix<GaloisPolynomial>> & keyMatrices, int rounds){
+    vector<QSMatrix<GaloisPolynomial>> inverseKeys;
+    for(int i=rounds; i>=0; i--){
+        QSMatrix<GaloisPolynomial> key = keyMatrices[i];
+        if(i != 0 && i != rounds) mixColumns_inverse(key);
+        inverseKeys.push_back(key);
+    }
+    return inverseKeys;
+}
+
+// Converts 16 bytes of text to a state matrix, bytes fill the state column by column
+// Shorter text is padded with zeros
+static QSMatrix<GaloisPolynomial> textToState(ConstByteSpan text){
     vector<GaloisPolynomial> sVec;
     sVec.reserve(16);
     for(int i=0; i<16; i++){
-        sVec.push_back(extractPoly(vplaintext));
+        sVec.push_back(GaloisPolynomial(i < text.size ? text.data[i] : 0));
     }
-    QSMatrix<GaloisPolynomial> state(4, 4, sVec);
-    
-    // Perform rounds on plaintext
+    return QSMatrix<GaloisPolynomial>(4, 4, sVec).transpose();
+}
+
+// Converts a state matrix back to 16 bytes of text, column by column
+static string stateToText(const QSMatrix<GaloisPolynomial> & state){
+    vector<unsigned char> vtext;
+    for(int j=0; j<4; j++){
+        for(int i=0; i<4; i++){
+            vtext.push_back(polyToChar(state(i,j)));
+        }
+    }
+    return string(vtext.begin(), vtext.end());
+}
+
+// Performs rounds of encryption on the state with the given round keys
+static void encryptState(QSMatrix<GaloisPolynomial> & state, const vector<QSMatrix<GaloisPolynomial>> & keyMatrices, int rounds){
     addRoundKey(state, keyMatrices[0]);
     for(int i=1; i<rounds; i++){
         subBytes(state);
@@ -304,60 +353,82 @@ string encrypt(string plaintext, string key, int rounds){
     subBytes(state);
     shiftRows(state);
     addRoundKey(state, keyMatrices[rounds]);
-    
-    // Convert back to string
-    vector<unsigned char> vciphertext;
-    for(int i=0; i<4; i++){
-        for(int j=0; j<4; j++){
-            vciphertext.push_back(polyToChar(state(i,j)));
-        }
+}
+
+// Undoes rounds of encryption on the state with the equivalent inverse cipher keys,
+// each round has the same shape as an encryption round
+static void decryptState(QSMatrix<GaloisPolynomial> & state, const vector<QSMatrix<GaloisPolynomial>> & inverseKeys, int rounds){
+    addRoundKey(state, inverseKeys[0]);
+    for(int i=1; i<rounds; i++){
+        subBytes_inverse(state);
+        shiftRows_inverse(state);
+        mixColumns_inverse(state);
+        addRoundKey(state, inverseKeys[i]);
     }
-    string ciphertext(vciphertext.begin(), vciphertext.end());
-    
-    return ciphertext;
+    subBytes_inverse(state);
+    shiftRows_inverse(state);
+    addRoundKey(state, inverseKeys[rounds]);
 }
 
-// Undoes rounds of AES on ciphertext with key
-string decrypt(string ciphertext, string key, int rounds){
+// Does rounds of AES encryption on plaintext with key, 0 rounds meaning the standard count for the key length
+string encrypt(const string & plaintext, const string & key, int rounds){
+    if(rounds == 0) rounds = standardRounds((int) key.size());
+    
+    // Every temporary of the call comes from this thread's arena, freed together at the end
+    ArenaScope arena;
+    
     // Set up Galois Field
     GaloisPolynomial::globalSetModulus(rijndael_Mod);
     
-    // Convert strings to unsigned characters
-    vector<unsigned char> vciphertext(ciphertext.begin(), ciphertext.end());
-    vector<unsigned char> vkey(key.begin(), key.end());
-    
     // Expand key
-    vector<QSMatrix<GaloisPolynomial>> keyMatrices = expandKey(vkey, rounds);
+    vector<QSMatrix<GaloisPolynomial>> keyMatrices = expandKey(ConstByteSpan(key), rounds);
     
-    // Convert ciphertext to matrix representation
-    vector<GaloisPolynomial> sVec;
-    sVec.reserve(16);
-    for(int i=0; i<16; i++){
-        sVec.push_back(extractPoly(vciphertext));
-    }
-    QSMatrix<GaloisPolynomial> state(4, 4, sVec);
+    // Perform rounds on plaintext
+    QSMatrix<GaloisPolynomial> state = textToState(plaintext);
+    encryptState(state, keyMatrices, rounds);
     
-    // Perform rounds on ciphertext
-    addRoundKey(state, keyMatrices[rounds]);
-    shiftRows_inverse(state);
-    subBytes_inverse(state);
-    for(int i=rounds-1; i>0; i--){
-        addRoundKey(state, keyMatrices[i]);
-        mixColumns_inverse(state);
-        shiftRows_inverse(state);
-        subBytes_inverse(state);
-    }
-    addRoundKey(state, keyMatrices[0]);
+    return stateToText(state);
+}
+
+// Undoes rounds of AES on ciphertext with key, 0 rounds meaning the standard count for the key length
+string decrypt(const string & ciphertext, const string & key, int rounds){
+    if(rounds == 0) rounds = standardRounds((int) key.size());
     
-    // Convert back to string
-    vector<unsigned char> vplaintext;
-    for(int i=0; i<4; i++){
-        for(int j=0; j<4; j++){
-            vplaintext.push_back(polyToChar(state(i,j)));
-        }
-    }
-    string plaintext(vplaintext.begin(), vplaintext.end());
+    // Temporaries come from the thread's arena, as in encrypt
+    ArenaScope arena;
+    
+    // Set up Galois Field
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    
+    // Expand key, then move inverse mix columns into the round keys
+    vector<QSMatrix<GaloisPolynomial>> inverseKeys = inverseKeySchedule(expandKey(ConstByteSpan(key), rounds), rounds);
+    
+    // Perform rounds on ciphertext
+    QSMatrix<GaloisPolynomial> state = textToState(ciphertext);
+    decryptState(state, inverseKeys, rounds);
     
+    return stateToText(state);
+}
+
+// Copies text into whole zero padded blocks, at least one
+static string padToBlocks(const string & text){
+    string blocks(text);
+    size_t length = text.size() == 0 ? AES_BLOCK_SIZE : (text.size() + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE * AES_BLOCK_SIZE;
+    blocks.resize(length, '\0');
+    return blocks;
+}
+
+// Encrypts plaintext with an already expanded key, padded with zeros to whole blocks
+string encrypt(const string & plaintext, const AesKey & key){
+    string ciphertext = padToBlocks(plaintext);
+    encrypt(ciphertext, ciphertext, key);
+    return ciphertext;
+}
+
+// Decrypts whole blocks of ciphertext with an already expanded key, a partial block throws
+string decrypt(const string & ciphertext, const AesKey & key){
+    string plaintext(ciphertext);
+    decrypt(plaintext, plaintext, key);
     return plaintext;
 }
 
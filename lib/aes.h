@@ -12,6 +12,8 @@
 
 #include "galois_field.h"
 #include "matrix.h"
+#include "aes_key.h"
+#include "instrument.h"
 #include <string>
 #include <vector>
 #include <cmath>
@@ -39,6 +41,8 @@ extern const QSMatrix<GaloisPolynomial> rijndael_M_inverse;
 
 // Perform p = A * p^(-1) + b
 GaloisPolynomial & sBox(GaloisPolynomial & p);
+// Perform p = A * p^(-1) + b for another affine map, A is n by n for a field of degree n
+GaloisPolynomial & sBox(GaloisPolynomial & p, const vector<Modular<int>> & A, const GaloisPolynomial & b);
 // Perform p = (A_inverse * p + b_inverse)^(-1) (inverse S-Box)
 GaloisPolynomial & sBox_inverse(GaloisPolynomial & p);
 
@@ -46,9 +50,9 @@ GaloisPolynomial & sBox_inverse(GaloisPolynomial & p);
 QSMatrix<GaloisPolynomial> & subBytes(QSMatrix<GaloisPolynomial> & state);
 // Perform s(i,j) = (A_inverse * p + b_inverse)^(-1) (inverse S-Box) for all 0<=i,j<=3
 QSMatrix<GaloisPolynomial> & subBytes_inverse(QSMatrix<GaloisPolynomial> & state);
-// Rotate each row right by its index
-QSMatrix<GaloisPolynomial> & shiftRows(QSMatrix<GaloisPolynomial> & state);
 // Rotate each row left by its index
+QSMatrix<GaloisPolynomial> & shiftRows(QSMatrix<GaloisPolynomial> & state);
+// Rotate each row right by its index
 QSMatrix<GaloisPolynomial> & shiftRows_inverse(QSMatrix<GaloisPolynomial> & state);
 // Performs state = M * state
 QSMatrix<GaloisPolynomial> & mixColumns(QSMatrix<GaloisPolynomial> & state);
@@ -64,12 +68,21 @@ GaloisPolynomial extractPoly(vector<unsigned char> & key);
 
 // Takes a 4 polynomial word and modifies it by Rijndael core operations
 vector<GaloisPolynomial>& keyExpandCore(vector<GaloisPolynomial> & word, int iteration);
-// Takes 16 byte (128 bit) key and returns rounds + 1 16 byte keys in matrix form
+// Takes a 16, 24 or 32 byte key and returns rounds + 1 16 byte keys in matrix form, throws for other lengths
 vector<QSMatrix<GaloisPolynomial>> expandKey(vector<unsigned char> key, int rounds);
+vector<QSMatrix<GaloisPolynomial>> expandKey(ConstByteSpan key, int rounds);
+// Reverses the round keys and applies inverse mix columns to all but the first and last
+vector<QSMatrix<GaloisPolynomial>> inverseKeySchedule(const vector<QSMatrix<GaloisPolynomial>> & keyMatrices, int rounds);
+
+// Does rounds of AES encryption on plaintext with a 16, 24 or 32 byte key, 0 rounds meaning the standard count
+string encrypt(const string & plaintext, const string & key, int rounds = 0);
+// Undoes rounds of AES on ciphertext with key, 0 rounds meaning the standard count
+string decrypt(const string & ciphertext, const string & key, int rounds = 0);
 
-// Does rounds of AES encryption on plaintext with key
-string encrypt(string plaintext, string key, int rounds = 10);
-// Undoes rounds of AES on ciphertext with key
-string decrypt(string ciphertext, string key, int rounds = 10);
+// Encrypts plaintext with an already expanded key, padded with zeros to whole blocks
+// This wraps the span API in aes_key.h and runs on the fast engines
+string encrypt(const string & plaintext, const AesKey & key);
+// Decrypts whole blocks of ciphertext with an already expanded key, a partial block throws
+string decrypt(const string & ciphertext, const AesKey & key);
 
 #endif
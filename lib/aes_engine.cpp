@@ -0,0 +1,710 @@
+/*
+ * aes_engine.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Byte oriented AES block engines. These operate on raw
+ * buffers and precomputed round keys, and produce the same
+ * output as encrypt() in aes.h for the same key and rounds.
+ * Consecutive blocks are independent, so the table and AES-NI
+ * engines run several of them through each round together and
+ * one block's latency hides behind the others' work.
+ */
+
+#ifndef AES_ENGINE_CPP
+#define AES_ENGINE_CPP
+
+#include "aes_engine.h"
+#include "aes_tables.h"
+#include "cpu_features.h"
+#include <utility>
+
+#ifdef AES_X86
+#include <immintrin.h>
+#define AES_NI_TARGET __attribute__((target("aes,sse2")))
+#endif
+
+// Read a state column with row 0 in the top byte
+static inline uint32_t loadColumn(const unsigned char * p){
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+// Write a state column with row 0 in the top byte
+static inline void storeColumn(unsigned char * p, uint32_t w){
+    p[0] = (unsigned char) (w >> 24);
+    p[1] = (unsigned char) (w >> 16);
+    p[2] = (unsigned char) (w >> 8);
+    p[3] = (unsigned char) w;
+}
+
+// Number of 32 bit words in a 16, 24 or 32 byte key
+int keyWords(int keyLength){
+    if(keyLength != 16 && keyLength != 24 && keyLength != 32){
+        throw runtime_error("Key must be 16, 24 or 32 bytes.");
+    }
+    return keyLength / 4;
+}
+
+// Rounds FIPS-197 uses for a 16, 24 or 32 byte key
+int standardRounds(int keyLength){
+    return keyWords(keyLength) + 6;
+}
+
+// Apply the S-Box to each byte of a word
+static inline uint32_t subWord(const AesTables & t, uint32_t w){
+    return ((uint32_t) t.sbox[w >> 24] << 24) | ((uint32_t) t.sbox[(w >> 16) & 0xff] << 16)
+         | ((uint32_t) t.sbox[(w >> 8) & 0xff] << 8) | (uint32_t) t.sbox[w & 0xff];
+}
+
+// The schedule is w[i] = w[i-nk] + g(w[i-1]), this is g for word i
+static inline uint32_t scheduleTemp(const AesTables & t, uint32_t w, int i, int nk){
+    if(i % nk == 0) return subWord(t, (w << 8) | (w >> 24)) ^ ((uint32_t) t.rcon[i / nk] << 24);
+    if(nk > 6 && i % nk == 4) return subWord(t, w);
+    return w;
+}
+
+// Expands all words of the key schedule
+static void expandKeyWords(const unsigned char * key, int keyLength, int rounds, uint32_t * w){
+    if(rounds < 1 || rounds > AES_MAX_ROUNDS) throw runtime_error("Unsupported number of rounds.");
+    int nk = keyWords(keyLength);
+    const AesTables & t = aesTables();
+    
+    // Just copy in key for the first nk words
+    for(int i=0; i<nk; i++){
+        w[i] = loadColumn(key + 4*i);
+    }
+    for(int i=nk; i<4*(rounds+1); i++){
+        w[i] = w[i-nk] ^ scheduleTemp(t, w[i-1], i, nk);
+    }
+}
+
+// Expands a 16, 24 or 32 byte key into rounds + 1 round keys of 16 bytes each
+void expandKeyBytes(const unsigned char * key, int keyLength, int rounds, unsigned char * roundKeys){
+    // Room for the nk words of a long key even when few rounds are asked for
+    uint32_t w[4*(AES_MAX_ROUNDS+1) + 8];
+    expandKeyWords(key, keyLength, rounds, w);
+    for(int i=0; i<4*(rounds+1); i++){
+        storeColumn(roundKeys + 4*i, w[i]);
+    }
+}
+
+// Writes the last keyLength bytes of the key schedule, where decryption starts
+void lastKeyBytes(const unsigned char * key, int keyLength, int rounds, unsigned char * lastKey){
+    uint32_t w[4*(AES_MAX_ROUNDS+1) + 8];
+    expandKeyWords(key, keyLength, rounds, w);
+    int nk = keyLength / 4;
+    int total = 4*(rounds+1);
+    for(int i=0; i<nk; i++){
+        storeColumn(lastKey + 4*i, w[total - nk + i]);
+    }
+}
+
+/*
+ * KeyWindow
+ * The last nk words of the schedule seen so far, in a ring indexed by
+ * word number mod nk. Since w[i] = w[i-nk] + g(w[i-1]) can be solved for
+ * w[i-nk], the window can slide forwards from the cipher key or
+ * backwards from the end of the schedule.
+ */
+struct KeyWindow{
+    uint32_t ring[8];
+    int nk;
+    int next;   // Next word forwards, or lowest word held going backwards
+    int slot;   // next % nk going forwards, kept so the walk never divides
+    int row;    // next / nk going forwards
+    
+    // Starts at word 0 with the cipher key
+    void startForward(const unsigned char * key, int keyLength){
+        nk = keyWords(keyLength);
+        for(int i=0; i<nk; i++){
+            ring[i] = loadColumn(key + 4*i);
+        }
+        next = 0;
+        slot = 0;
+        row = 0;
+    }
+    
+    // Starts after the last word with the last nk words of the schedule
+    void startBackward(const unsigned char * lastKey, int keyLength, int rounds){
+        nk = keyWords(keyLength);
+        next = 4*(rounds+1);
+        for(int i=0; i<nk; i++){
+            ring[(next - nk + i) % nk] = loadColumn(lastKey + 4*i);
+        }
+    }
+    
+    // Returns word next and moves up by one, the same step as scheduleTemp with slot and row for i % nk and i / nk
+    uint32_t forward(const AesTables & t){
+        next++;
+        uint32_t & w = ring[slot];
+        if(row != 0){
+            uint32_t previous = ring[slot == 0 ? nk - 1 : slot - 1];
+            if(slot == 0) w ^= subWord(t, (previous << 8) | (previous >> 24)) ^ ((uint32_t) t.rcon[row] << 24);
+            else if(nk > 6 && slot == 4) w ^= subWord(t, previous);
+            else w ^= previous;
+        }
+        uint32_t result = w;
+        if(++slot == nk){
+            slot = 0;
+            row++;
+        }
+        return result;
+    }
+    
+    // Returns word next - 1 and moves down by one
+    uint32_t backward(const AesTables & t){
+        int i = --next;
+        uint32_t w = ring[i % nk];
+        // Replace w[i] in the ring by w[i-nk] once it is handed out
+        if(i >= nk) ring[i % nk] ^= scheduleTemp(t, ring[(i-1) % nk], i, nk);
+        return w;
+    }
+};
+
+// Recovers the cipher key from the last keyLength bytes of the schedule, undoing lastKeyBytes
+void firstKeyBytes(const unsigned char * lastKey, int keyLength, int rounds, unsigned char * key){
+    const AesTables & t = aesTables();
+    KeyWindow window;
+    window.startBackward(lastKey, keyLength, rounds);
+    while(window.next > window.nk) window.backward(t);
+    for(int i=0; i<window.nk; i++){
+        storeColumn(key + 4*i, window.ring[i]);
+    }
+}
+
+// Returns the engine that will actually run for a requested engine
+AesEngine resolveEngine(AesEngine engine){
+    if(engine == ENGINE_AUTO || engine == ENGINE_HARDWARE){
+        return cpuHasAesni() ? ENGINE_HARDWARE : ENGINE_TABLE;
+    }
+    return engine;
+}
+
+// Performs column = M_inverse * column on a packed column, through the fused tables since
+// td[r][S(x)] is column r of M_inverse times x
+static inline uint32_t mixColumnWord_inverse(const AesTables & t, uint32_t w){
+    return t.td[0][t.sbox[w >> 24]] ^ t.td[1][t.sbox[(w >> 16) & 0xff]]
+         ^ t.td[2][t.sbox[(w >> 8) & 0xff]] ^ t.td[3][t.sbox[w & 0xff]];
+}
+
+// Derives the equivalent inverse cipher keys: reversed, with inverse mix columns on the middle keys
+void inverseKeyBytes(const unsigned char * roundKeys, int rounds, unsigned char * inverseKeys){
+    const AesTables & t = aesTables();
+    for(int r=0; r<=rounds; r++){
+        const unsigned char * from = roundKeys + 16*(rounds - r);
+        unsigned char * to = inverseKeys + 16*r;
+        for(int c=0; c<4; c++){
+            uint32_t w = loadColumn(from + 4*c);
+            if(r != 0 && r != rounds) w = mixColumnWord_inverse(t, w);
+            storeColumn(to + 4*c, w);
+        }
+    }
+}
+
+// Reads precomputed round key words in order
+struct StoredKeys{
+    const unsigned char * rk;
+    
+    uint32_t word(){
+        uint32_t w = loadColumn(rk);
+        rk += 4;
+        return w;
+    }
+};
+
+// Derives round key words in order as the rounds need them
+struct DerivedKeys{
+    const AesTables & t;
+    KeyWindow window;
+    
+    uint32_t word(){
+        return window.forward(t);
+    }
+};
+
+// Derives equivalent inverse cipher key words in order by walking the schedule backwards,
+// a whole round key is fetched at once since its words come out last first
+struct InverseDerivedKeys{
+    const AesTables & t;
+    KeyWindow window;
+    int rounds;
+    int round;      // Inverse round key the buffer holds
+    int used;       // Words of the buffer handed out
+    uint32_t k[4];
+    
+    uint32_t word(){
+        if(used == 4){
+            round++;
+            for(int c=3; c>=0; c--){
+                k[c] = window.backward(t);
+                if(round != 0 && round != rounds) k[c] = mixColumnWord_inverse(t, k[c]);
+            }
+            used = 0;
+        }
+        return k[used++];
+    }
+};
+
+// Blocks the table engine runs in lockstep. Two states and their temporaries fit the integer registers,
+// at four they spill and run no faster than one block at a time
+static const size_t TABLE_LANES = 2;
+
+// One middle round on a state of four columns: each column is the sum of four table lookups,
+// shift rows picks the source columns
+static inline void encryptRound(const AesTables & t, uint32_t * s, const uint32_t * k){
+    uint32_t t0 = t.te[0][s[0] >> 24] ^ t.te[1][(s[1] >> 16) & 0xff]
+                ^ t.te[2][(s[2] >> 8) & 0xff] ^ t.te[3][s[3] & 0xff] ^ k[0];
+    uint32_t t1 = t.te[0][s[1] >> 24] ^ t.te[1][(s[2] >> 16) & 0xff]
+                ^ t.te[2][(s[3] >> 8) & 0xff] ^ t.te[3][s[0] & 0xff] ^ k[1];
+    uint32_t t2 = t.te[0][s[2] >> 24] ^ t.te[1][(s[3] >> 16) & 0xff]
+                ^ t.te[2][(s[0] >> 8) & 0xff] ^ t.te[3][s[1] & 0xff] ^ k[2];
+    uint32_t t3 = t.te[0][s[3] >> 24] ^ t.te[1][(s[0] >> 16) & 0xff]
+                ^ t.te[2][(s[1] >> 8) & 0xff] ^ t.te[3][s[2] & 0xff] ^ k[3];
+    s[0] = t0; s[1] = t1; s[2] = t2; s[3] = t3;
+}
+
+// Last round has no mix columns, it writes the output block
+static inline void encryptLastRound(const AesTables & t, const uint32_t * s, const uint32_t * k, unsigned char * out){
+    const unsigned char * sb = t.sbox;
+    uint32_t u0 = ((uint32_t) sb[s[0] >> 24] << 24) | ((uint32_t) sb[(s[1] >> 16) & 0xff] << 16)
+                | ((uint32_t) sb[(s[2] >> 8) & 0xff] << 8) | (uint32_t) sb[s[3] & 0xff];
+    uint32_t u1 = ((uint32_t) sb[s[1] >> 24] << 24) | ((uint32_t) sb[(s[2] >> 16) & 0xff] << 16)
+                | ((uint32_t) sb[(s[3] >> 8) & 0xff] << 8) | (uint32_t) sb[s[0] & 0xff];
+    uint32_t u2 = ((uint32_t) sb[s[2] >> 24] << 24) | ((uint32_t) sb[(s[3] >> 16) & 0xff] << 16)
+                | ((uint32_t) sb[(s[0] >> 8) & 0xff] << 8) | (uint32_t) sb[s[1] & 0xff];
+    uint32_t u3 = ((uint32_t) sb[s[3] >> 24] << 24) | ((uint32_t) sb[(s[0] >> 16) & 0xff] << 16)
+                | ((uint32_t) sb[(s[1] >> 8) & 0xff] << 8) | (uint32_t) sb[s[2] & 0xff];
+    storeColumn(out,      u0 ^ k[0]);
+    storeColumn(out + 4,  u1 ^ k[1]);
+    storeColumn(out + 8,  u2 ^ k[2]);
+    storeColumn(out + 12, u3 ^ k[3]);
+}
+
+// Inverse shift rows moves row i right by i, so row i of column c comes from column c - i
+static inline void decryptRound(const AesTables & t, uint32_t * s, const uint32_t * k){
+    uint32_t t0 = t.td[0][s[0] >> 24] ^ t.td[1][(s[3] >> 16) & 0xff]
+                ^ t.td[2][(s[2] >> 8) & 0xff] ^ t.td[3][s[1] & 0xff] ^ k[0];
+    uint32_t t1 = t.td[0][s[1] >> 24] ^ t.td[1][(s[0] >> 16) & 0xff]
+                ^ t.td[2][(s[3] >> 8) & 0xff] ^ t.td[3][s[2] & 0xff] ^ k[1];
+    uint32_t t2 = t.td[0][s[2] >> 24] ^ t.td[1][(s[1] >> 16) & 0xff]
+                ^ t.td[2][(s[0] >> 8) & 0xff] ^ t.td[3][s[3] & 0xff] ^ k[2];
+    uint32_t t3 = t.td[0][s[3] >> 24] ^ t.td[1][(s[2] >> 16) & 0xff]
+                ^ t.td[2][(s[1] >> 8) & 0xff] ^ t.td[3][s[0] & 0xff] ^ k[3];
+    s[0] = t0; s[1] = t1; s[2] = t2; s[3] = t3;
+}
+
+// Last round has no inverse mix columns, it writes the output block
+static inline void decryptLastRound(const AesTables & t, const uint32_t * s, const uint32_t * k, unsigned char * out){
+    const unsigned char * sb = t.sbox_inverse;
+    uint32_t u0 = ((uint32_t) sb[s[0] >> 24] << 24) | ((uint32_t) sb[(s[3] >> 16) & 0xff] << 16)
+                | ((uint32_t) sb[(s[2] >> 8) & 0xff] << 8) | (uint32_t) sb[s[1] & 0xff];
+    uint32_t u1 = ((uint32_t) sb[s[1] >> 24] << 24) | ((uint32_t) sb[(s[0] >> 16) & 0xff] << 16)
+                | ((uint32_t) sb[(s[3] >> 8) & 0xff] << 8) | (uint32_t) sb[s[2] & 0xff];
+    uint32_t u2 = ((uint32_t) sb[s[2] >> 24] << 24) | ((uint32_t) sb[(s[1] >> 16) & 0xff] << 16)
+                | ((uint32_t) sb[(s[0] >> 8) & 0xff] << 8) | (uint32_t) sb[s[3] & 0xff];
+    uint32_t u3 = ((uint32_t) sb[s[3] >> 24] << 24) | ((uint32_t) sb[(s[2] >> 16) & 0xff] << 16)
+                | ((uint32_t) sb[(s[1] >> 8) & 0xff] << 8) | (uint32_t) sb[s[0] & 0xff];
+    storeColumn(out,      u0 ^ k[0]);
+    storeColumn(out + 4,  u1 ^ k[1]);
+    storeColumn(out + 8,  u2 ^ k[2]);
+    storeColumn(out + 12, u3 ^ k[3]);
+}
+
+// Takes the next four round key words
+template<typename Keys>
+static inline void nextRoundKey(Keys & keys, uint32_t * k){
+    k[0] = keys.word();
+    k[1] = keys.word();
+    k[2] = keys.word();
+    k[3] = keys.word();
+}
+
+// Reads a block into a state and adds the first round key
+static inline void firstRound(uint32_t * s, const uint32_t * k, const unsigned char * in){
+    s[0] = loadColumn(in)      ^ k[0];
+    s[1] = loadColumn(in + 4)  ^ k[1];
+    s[2] = loadColumn(in + 8)  ^ k[2];
+    s[3] = loadColumn(in + 12) ^ k[3];
+}
+
+// Encrypts a single block using the fused lookup tables, round keys come from keys
+template<typename Keys>
+static inline void encryptBlockWith(const AesTables & t, Keys & keys, int rounds,
+                                    const unsigned char * in, unsigned char * out){
+    uint32_t s[4], k[4];
+    nextRoundKey(keys, k);
+    firstRound(s, k, in);
+    for(int r=1; r<rounds; r++){
+        nextRoundKey(keys, k);
+        encryptRound(t, s, k);
+    }
+    nextRoundKey(keys, k);
+    encryptLastRound(t, s, k, out);
+}
+
+// Encrypts consecutive blocks, one per lane, in lockstep, each round key is read once for all of them and
+// the lookups of one block issue while another waits on its loads
+template<size_t... L>
+static inline void encryptLanes(const AesTables & t, const unsigned char * roundKeys, int rounds,
+                                const unsigned char * in, unsigned char * out, std::index_sequence<L...>){
+    StoredKeys keys = { roundKeys };
+    uint32_t s[sizeof...(L)][4], k[4];
+    nextRoundKey(keys, k);
+    int first[] = { (firstRound(s[L], k, in + 16*L), 0)... };
+    (void) first;
+    for(int r=1; r<rounds; r++){
+        nextRoundKey(keys, k);
+        int round[] = { (encryptRound(t, s[L], k), 0)... };
+        (void) round;
+    }
+    nextRoundKey(keys, k);
+    int last[] = { (encryptLastRound(t, s[L], k, out + 16*L), 0)... };
+    (void) last;
+}
+
+// Encrypts a single block using the fused lookup tables
+void encryptBlockTable(const unsigned char * roundKeys, int rounds, const unsigned char * in, unsigned char * out){
+    StoredKeys keys = { roundKeys };
+    encryptBlockWith(aesTables(), keys, rounds, in, out);
+}
+
+// Encrypts consecutive blocks using the fused lookup tables, TABLE_LANES at a time
+void encryptBlocksTable(const unsigned char * roundKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks){
+    const AesTables & t = aesTables();
+    size_t b = 0;
+    for(; b+TABLE_LANES<=blocks; b+=TABLE_LANES){
+        encryptLanes(t, roundKeys, rounds, in + 16*b, out + 16*b, std::make_index_sequence<TABLE_LANES>());
+    }
+    for(; b<blocks; b++){
+        StoredKeys keys = { roundKeys };
+        encryptBlockWith(t, keys, rounds, in + 16*b, out + 16*b);
+    }
+}
+
+// Decrypts a single block with the equivalent inverse cipher, which has the same
+// round structure as encryption so it fuses into the td tables the same way
+template<typename Keys>
+static inline void decryptBlockWith(const AesTables & t, Keys & keys, int rounds,
+                                    const unsigned char * in, unsigned char * out){
+    uint32_t s[4], k[4];
+    nextRoundKey(keys, k);
+    firstRound(s, k, in);
+    for(int r=1; r<rounds; r++){
+        nextRoundKey(keys, k);
+        decryptRound(t, s, k);
+    }
+    nextRoundKey(keys, k);
+    decryptLastRound(t, s, k, out);
+}
+
+// Decrypts consecutive blocks, one per lane, in lockstep with the equivalent inverse cipher keys
+template<size_t... L>
+static inline void decryptLanes(const AesTables & t, const unsigned char * inverseKeys, int rounds,
+                                const unsigned char * in, unsigned char * out, std::index_sequence<L...>){
+    StoredKeys keys = { inverseKeys };
+    uint32_t s[sizeof...(L)][4], k[4];
+    nextRoundKey(keys, k);
+    int first[] = { (firstRound(s[L], k, in + 16*L), 0)... };
+    (void) first;
+    for(int r=1; r<rounds; r++){
+        nextRoundKey(keys, k);
+        int round[] = { (decryptRound(t, s[L], k), 0)... };
+        (void) round;
+    }
+    nextRoundKey(keys, k);
+    int last[] = { (decryptLastRound(t, s[L], k, out + 16*L), 0)... };
+    (void) last;
+}
+
+// Decrypts consecutive blocks with the equivalent inverse cipher keys, TABLE_LANES at a time
+void decryptBlocksTable(const unsigned char * inverseKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks){
+    const AesTables & t = aesTables();
+    size_t b = 0;
+    for(; b+TABLE_LANES<=blocks; b+=TABLE_LANES){
+        decryptLanes(t, inverseKeys, rounds, in + 16*b, out + 16*b, std::make_index_sequence<TABLE_LANES>());
+    }
+    for(; b<blocks; b++){
+        StoredKeys keys = { inverseKeys };
+        decryptBlockWith(t, keys, rounds, in + 16*b, out + 16*b);
+    }
+}
+
+// CBC-MAC chaining: for each block sets state = E(state ^ block)
+void cbcMacBlocksTable(const unsigned char * roundKeys, int rounds, unsigned char * state, const unsigned char * in, size_t blocks){
+    const AesTables & t = aesTables();
+    for(size_t b=0; b<blocks; b++){
+        for(int i=0; i<16; i++) state[i] ^= in[16*b + i];
+        StoredKeys keys = { roundKeys };
+        encryptBlockWith(t, keys, rounds, state, state);
+    }
+}
+
+// Encrypts blocks deriving each round key from the cipher key as its round starts
+void encryptBlocksOnTheFly(const unsigned char * key, int keyLength, int rounds,
+                           const unsigned char * in, unsigned char * out, size_t blocks){
+    if(rounds < 1 || rounds > AES_MAX_ROUNDS) throw runtime_error("Unsupported number of rounds.");
+    const AesTables & t = aesTables();
+    for(size_t b=0; b<blocks; b++){
+        DerivedKeys keys = { t, KeyWindow() };
+        keys.window.startForward(key, keyLength);
+        encryptBlockWith(t, keys, rounds, in + 16*b, out + 16*b);
+    }
+}
+
+// Decrypts blocks with the equivalent inverse cipher, walking the schedule backwards from the last round key
+void decryptBlocksOnTheFly(const unsigned char * lastKey, int keyLength, int rounds,
+                           const unsigned char * in, unsigned char * out, size_t blocks){
+    if(rounds < 1 || rounds > AES_MAX_ROUNDS) throw runtime_error("Unsupported number of rounds.");
+    const AesTables & t = aesTables();
+    for(size_t b=0; b<blocks; b++){
+        // No round key is buffered yet, so the first word fetches round 0
+        InverseDerivedKeys keys = { t, KeyWindow(), rounds, -1, 4, { 0, 0, 0, 0 } };
+        keys.window.startBackward(lastKey, keyLength, rounds);
+        decryptBlockWith(t, keys, rounds, in + 16*b, out + 16*b);
+    }
+}
+
+// Encrypts one block under each of consecutive keys, one per lane, in lockstep. Each lane slides its own
+// key window a round at a time, so one lane's schedule steps and lookups issue while another waits on its loads
+template<size_t... L>
+static inline void encryptKeyLanes(const AesTables & t, const unsigned char * keys, int keyLength, int rounds,
+                                   const unsigned char * in, unsigned char * out, std::index_sequence<L...>){
+    DerivedKeys walkers[sizeof...(L)] = { ((void) L, DerivedKeys{ t, KeyWindow() })... };
+    uint32_t s[sizeof...(L)][4], k[sizeof...(L)][4];
+    int first[] = { (walkers[L].window.startForward(keys + keyLength*L, keyLength),
+                     nextRoundKey(walkers[L], k[L]), firstRound(s[L], k[L], in + 16*L), 0)... };
+    (void) first;
+    for(int r=1; r<rounds; r++){
+        int round[] = { (nextRoundKey(walkers[L], k[L]), encryptRound(t, s[L], k[L]), 0)... };
+        (void) round;
+    }
+    int last[] = { (nextRoundKey(walkers[L], k[L]), encryptLastRound(t, s[L], k[L], out + 16*L), 0)... };
+    (void) last;
+}
+
+// Encrypts block i under key i, keys packed keyLength bytes apart, TABLE_LANES keys expanded and encrypted together
+void encryptBlocksMultiKeyTable(const unsigned char * keys, int keyLength, int rounds,
+                                const unsigned char * in, unsigned char * out, size_t count){
+    if(rounds < 1 || rounds > AES_MAX_ROUNDS) throw runtime_error("Unsupported number of rounds.");
+    const AesTables & t = aesTables();
+    size_t i = 0;
+    for(; i+TABLE_LANES<=count; i+=TABLE_LANES){
+        encryptKeyLanes(t, keys + keyLength*i, keyLength, rounds, in + 16*i, out + 16*i, std::make_index_sequence<TABLE_LANES>());
+    }
+    for(; i<count; i++){
+        encryptBlocksOnTheFly(keys + keyLength*i, keyLength, rounds, in + 16*i, out + 16*i, 1);
+    }
+}
+
+#ifdef AES_X86
+
+// Keys expanded and blocks encrypted side by side by the multi key engine
+static const int MULTI_KEY_LANES = 4;
+
+// SubWord of the last word of k, in every word. All columns are equal, so shift rows does nothing
+AES_NI_TARGET static inline __m128i subLastWord(__m128i k){
+    return _mm_aesenclast_si128(_mm_shuffle_epi32(k, 0xff), _mm_setzero_si128());
+}
+
+// RotWord then add rcon, in every word
+AES_NI_TARGET static inline __m128i rotWordRcon(__m128i x, unsigned char rcon){
+    x = _mm_or_si128(_mm_srli_epi32(x, 8), _mm_slli_epi32(x, 24));
+    return _mm_xor_si128(x, _mm_set1_epi32(rcon));
+}
+
+// Next four schedule words: each word of k adds all the words before it, then g
+AES_NI_TARGET static inline __m128i nextKeyWords(__m128i k, __m128i g){
+    k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    k = _mm_xor_si128(k, _mm_slli_si128(k, 8));
+    return _mm_xor_si128(k, g);
+}
+
+// Encrypts block i under key i using AES-NI, expanding several keys in registers while their blocks encrypt
+AES_NI_TARGET void encryptBlocksMultiKeyHardware(const unsigned char * keys, int keyLength, int rounds,
+                                                 const unsigned char * in, unsigned char * out, size_t count){
+    if(rounds < 1 || rounds > AES_MAX_ROUNDS) throw runtime_error("Unsupported number of rounds.");
+    int nk = keyWords(keyLength);
+    
+    // Six word schedules do not line up with whole registers, so those are expanded in words
+    if(nk == 6){
+        unsigned char roundKeys[16*(AES_MAX_ROUNDS+1)];
+        for(size_t i=0; i<count; i++){
+            expandKeyBytes(keys + 24*i, 24, rounds, roundKeys);
+            encryptBlocksHardware(roundKeys, rounds, in + 16*i, out + 16*i, 1);
+        }
+        return;
+    }
+    
+    const AesTables & t = aesTables();
+    for(size_t i=0; i<count; i+=MULTI_KEY_LANES){
+        int n = count - i < (size_t) MULTI_KEY_LANES ? (int) (count - i) : MULTI_KEY_LANES;
+        
+        // a and b hold the newest two round keys of each 256 bit schedule, a alone for 128 bit keys
+        __m128i a[MULTI_KEY_LANES], b[MULTI_KEY_LANES], s[MULTI_KEY_LANES];
+        for(int l=0; l<n; l++){
+            const unsigned char * key = keys + keyLength*(i + l);
+            a[l] = _mm_loadu_si128((const __m128i *) key);
+            b[l] = nk == 8 ? _mm_loadu_si128((const __m128i *) (key + 16)) : _mm_setzero_si128();
+            s[l] = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (in + 16*(i + l))), a[l]);
+        }
+        
+        // The lanes do not depend on each other, so their key steps and rounds overlap
+        for(int r=1; r<=rounds; r++){
+            for(int l=0; l<n; l++){
+                __m128i k;
+                if(nk == 4){
+                    a[l] = nextKeyWords(a[l], rotWordRcon(subLastWord(a[l]), t.rcon[r]));
+                    k = a[l];
+                }
+                else if(r == 1){
+                    k = b[l];
+                }
+                else if(r % 2 == 0){
+                    a[l] = nextKeyWords(a[l], rotWordRcon(subLastWord(b[l]), t.rcon[r / 2]));
+                    k = a[l];
+                }
+                else{
+                    b[l] = nextKeyWords(b[l], subLastWord(a[l]));
+                    k = b[l];
+                }
+                s[l] = r < rounds ? _mm_aesenc_si128(s[l], k) : _mm_aesenclast_si128(s[l], k);
+            }
+        }
+        
+        for(int l=0; l<n; l++){
+            _mm_storeu_si128((__m128i *) (out + 16*(i + l)), s[l]);
+        }
+    }
+}
+
+// Blocks AES-NI runs in lockstep, enough to cover the latency of each aesenc with independent ones
+static const size_t HARDWARE_LANES = 8;
+
+// Encrypts consecutive blocks, one per lane, in lockstep with AES-NI
+template<size_t... L>
+AES_NI_TARGET static inline void encryptLanesHardware(const __m128i * k, int rounds, const unsigned char * in,
+                                                unsigned char * out, std::index_sequence<L...>){
+    __m128i s[] = { _mm_xor_si128(_mm_loadu_si128((const __m128i *) (in + 16*L)), k[0])... };
+    for(int r=1; r<rounds; r++){
+        int round[] = { (s[L] = _mm_aesenc_si128(s[L], k[r]), 0)... };
+        (void) round;
+    }
+    int last[] = { (_mm_storeu_si128((__m128i *) (out + 16*L), _mm_aesenclast_si128(s[L], k[rounds])), 0)... };
+    (void) last;
+}
+
+// Encrypts consecutive blocks using AES-NI, HARDWARE_LANES at a time
+AES_NI_TARGET void encryptBlocksHardware(const unsigned char * roundKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks){
+    __m128i k[AES_MAX_ROUNDS+1];
+    for(int r=0; r<=rounds; r++){
+        k[r] = _mm_loadu_si128((const __m128i *) (roundKeys + 16*r));
+    }
+    
+    size_t b = 0;
+    for(; b+HARDWARE_LANES<=blocks; b+=HARDWARE_LANES){
+        encryptLanesHardware(k, rounds, in + 16*b, out + 16*b, std::make_index_sequence<HARDWARE_LANES>());
+    }
+    for(; b<blocks; b++){
+        encryptLanesHardware(k, rounds, in + 16*b, out + 16*b, std::make_index_sequence<1>());
+    }
+}
+
+// Decrypts consecutive blocks, one per lane, in lockstep with AES-NI
+template<size_t... L>
+AES_NI_TARGET static inline void decryptLanesHardware(const __m128i * k, int rounds, const unsigned char * in,
+                                                unsigned char * out, std::index_sequence<L...>){
+    __m128i s[] = { _mm_xor_si128(_mm_loadu_si128((const __m128i *) (in + 16*L)), k[0])... };
+    for(int r=1; r<rounds; r++){
+        int round[] = { (s[L] = _mm_aesdec_si128(s[L], k[r]), 0)... };
+        (void) round;
+    }
+    int last[] = { (_mm_storeu_si128((__m128i *) (out + 16*L), _mm_aesdeclast_si128(s[L], k[rounds])), 0)... };
+    (void) last;
+}
+
+// Decrypts consecutive blocks using AES-NI with the equivalent inverse cipher keys, HARDWARE_LANES at a time
+AES_NI_TARGET void decryptBlocksHardware(const unsigned char * inverseKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks){
+    __m128i k[AES_MAX_ROUNDS+1];
+    for(int r=0; r<=rounds; r++){
+        k[r] = _mm_loadu_si128((const __m128i *) (inverseKeys + 16*r));
+    }
+    
+    size_t b = 0;
+    for(; b+HARDWARE_LANES<=blocks; b+=HARDWARE_LANES){
+        decryptLanesHardware(k, rounds, in + 16*b, out + 16*b, std::make_index_sequence<HARDWARE_LANES>());
+    }
+    for(; b<blocks; b++){
+        decryptLanesHardware(k, rounds, in + 16*b, out + 16*b, std::make_index_sequence<1>());
+    }
+}
+
+// CBC-MAC chaining using AES-NI, each block waits on the one before so only one is in flight
+AES_NI_TARGET void cbcMacBlocksHardware(const unsigned char * roundKeys, int rounds, unsigned char * state, const unsigned char * in, size_t blocks){
+    __m128i k[AES_MAX_ROUNDS+1];
+    for(int r=0; r<=rounds; r++){
+        k[r] = _mm_loadu_si128((const __m128i *) (roundKeys + 16*r));
+    }
+    
+    __m128i s = _mm_loadu_si128((const __m128i *) state);
+    for(size_t b=0; b<blocks; b++){
+        s = _mm_xor_si128(s, _mm_loadu_si128((const __m128i *) (in + 16*b)));
+        s = _mm_xor_si128(s, k[0]);
+        for(int r=1; r<rounds; r++){
+            s = _mm_aesenc_si128(s, k[r]);
+        }
+        s = _mm_aesenclast_si128(s, k[rounds]);
+    }
+    _mm_storeu_si128((__m128i *) state, s);
+}
+
+#else
+
+// Without AES-NI the hardware engine falls back to the tables
+void encryptBlocksHardware(const unsigned char * roundKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks){
+    encryptBlocksTable(roundKeys, rounds, in, out, blocks);
+}
+
+void decryptBlocksHardware(const unsigned char * inverseKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks){
+    decryptBlocksTable(inverseKeys, rounds, in, out, blocks);
+}
+
+void cbcMacBlocksHardware(const unsigned char * roundKeys, int rounds, unsigned char * state, const unsigned char * in, size_t blocks){
+    cbcMacBlocksTable(roundKeys, rounds, state, in, blocks);
+}
+
+void encryptBlocksMultiKeyHardware(const unsigned char * keys, int keyLength, int rounds,
+                                   const unsigned char * in, unsigned char * out, size_t count){
+    encryptBlocksMultiKeyTable(keys, keyLength, rounds, in, out, count);
+}
+
+#endif
+
+// Encrypts consecutive blocks on the given engine
+void encryptBlocks(AesEngine engine, const unsigned char * roundKeys, int rounds,
+                   const unsigned char * in, unsigned char * out, size_t blocks){
+    if(resolveEngine(engine) == ENGINE_HARDWARE) encryptBlocksHardware(roundKeys, rounds, in, out, blocks);
+    else encryptBlocksTable(roundKeys, rounds, in, out, blocks);
+}
+
+// Decrypts consecutive blocks on the given engine
+void decryptBlocks(AesEngine engine, const unsigned char * inverseKeys, int rounds,
+                   const unsigned char * in, unsigned char * out, size_t blocks){
+    if(resolveEngine(engine) == ENGINE_HARDWARE) decryptBlocksHardware(inverseKeys, rounds, in, out, blocks);
+    else decryptBlocksTable(inverseKeys, rounds, in, out, blocks);
+}
+
+// Encrypts block i under key i on the given engine, for many keys used once each
+void encryptBlocksMultiKey(AesEngine engine, const unsigned char * keys, int keyLength, int rounds,
+                           const unsigned char * in, unsigned char * out, size_t count){
+    if(resolveEngine(engine) == ENGINE_HARDWARE) encryptBlocksMultiKeyHardware(keys, keyLength, rounds, in, out, count);
+    else encryptBlocksMultiKeyTable(keys, keyLength, rounds, in, out, count);
+}
+
+// CBC-MAC chains blocks into state on the given engine
+void cbcMacBlocks(AesEngine engine, const unsigned char * roundKeys, int rounds,
+                  unsigned char * state, const unsigned char * in, size_t blocks){
+    if(resolveEngine(engine) == ENGINE_HARDWARE) cbcMacBlocksHardware(roundKeys, rounds, state, in, blocks);
+    else cbcMacBlocksTable(roundKeys, rounds, state, in, blocks);
+}
+
+#endif
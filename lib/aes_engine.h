@@ -0,0 +1,94 @@
+/*
+ * aes_engine.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Byte oriented AES block engines. These operate on raw
+ * buffers and precomputed round keys, and produce the same
+ * output as encrypt() in aes.h for the same key and rounds.
+ * Consecutive blocks are independent, so the table and AES-NI
+ * engines run several of them through each round together and
+ * one block's latency hides behind the others' work.
+ */
+
+#ifndef AES_ENGINE_H
+#define AES_ENGINE_H
+
+#include <cstddef>
+#include <stdexcept>
+
+using std::size_t;
+using std::runtime_error;
+
+// Size of an AES block in bytes
+const int AES_BLOCK_SIZE = 16;
+// Most rounds the byte engines hold round keys for
+const int AES_MAX_ROUNDS = 14;
+
+enum AesEngine{
+    ENGINE_AUTO,        // Fastest engine the processor supports
+    ENGINE_TABLE,       // Fused lookup tables in portable C++
+    ENGINE_HARDWARE     // AES-NI instructions
+};
+
+// Returns the engine that will actually run for a requested engine
+AesEngine resolveEngine(AesEngine engine);
+
+// Number of 32 bit words in a 16, 24 or 32 byte key (Nk in FIPS-197)
+int keyWords(int keyLength);
+// Rounds FIPS-197 uses for a 16, 24 or 32 byte key
+int standardRounds(int keyLength);
+// Expands a 16, 24 or 32 byte key into rounds + 1 round keys of 16 bytes each
+void expandKeyBytes(const unsigned char * key, int keyLength, int rounds, unsigned char * roundKeys);
+// Writes the last keyLength bytes of the key schedule, where decryption starts
+void lastKeyBytes(const unsigned char * key, int keyLength, int rounds, unsigned char * lastKey);
+// Recovers the cipher key from the last keyLength bytes of the schedule, undoing lastKeyBytes
+void firstKeyBytes(const unsigned char * lastKey, int keyLength, int rounds, unsigned char * key);
+// Derives the equivalent inverse cipher keys: reversed, with inverse mix columns on the middle keys
+void inverseKeyBytes(const unsigned char * roundKeys, int rounds, unsigned char * inverseKeys);
+
+// Encrypts a single block using the fused lookup tables
+void encryptBlockTable(const unsigned char * roundKeys, int rounds, const unsigned char * in, unsigned char * out);
+// Encrypts consecutive blocks using the fused lookup tables
+void encryptBlocksTable(const unsigned char * roundKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks);
+// Decrypts consecutive blocks with the equivalent inverse cipher keys
+void decryptBlocksTable(const unsigned char * inverseKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks);
+
+// Encrypts blocks deriving each round key from the cipher key as its round starts
+void encryptBlocksOnTheFly(const unsigned char * key, int keyLength, int rounds,
+                           const unsigned char * in, unsigned char * out, size_t blocks);
+// Decrypts blocks with the equivalent inverse cipher, walking the schedule backwards from the last round key
+void decryptBlocksOnTheFly(const unsigned char * lastKey, int keyLength, int rounds,
+                           const unsigned char * in, unsigned char * out, size_t blocks);
+
+// Encrypts consecutive blocks using AES-NI
+void encryptBlocksHardware(const unsigned char * roundKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks);
+// Decrypts consecutive blocks using AES-NI with the equivalent inverse cipher keys
+void decryptBlocksHardware(const unsigned char * inverseKeys, int rounds, const unsigned char * in, unsigned char * out, size_t blocks);
+
+// CBC-MAC chaining: for each block sets state = E(state ^ block)
+void cbcMacBlocksTable(const unsigned char * roundKeys, int rounds, unsigned char * state, const unsigned char * in, size_t blocks);
+// CBC-MAC chaining using AES-NI, the state stays in a register between blocks
+void cbcMacBlocksHardware(const unsigned char * roundKeys, int rounds, unsigned char * state, const unsigned char * in, size_t blocks);
+
+// Encrypts block i under key i, keys packed keyLength bytes apart, deriving each schedule as its rounds start
+void encryptBlocksMultiKeyTable(const unsigned char * keys, int keyLength, int rounds,
+                                const unsigned char * in, unsigned char * out, size_t count);
+// Encrypts block i under key i using AES-NI, expanding several keys in registers while their blocks encrypt
+void encryptBlocksMultiKeyHardware(const unsigned char * keys, int keyLength, int rounds,
+                                   const unsigned char * in, unsigned char * out, size_t count);
+
+// Encrypts consecutive blocks on the given engine
+void encryptBlocks(AesEngine engine, const unsigned char * roundKeys, int rounds,
+                   const unsigned char * in, unsigned char * out, size_t blocks);
+// Decrypts consecutive blocks on the given engine
+void decryptBlocks(AesEngine engine, const unsigned char * inverseKeys, int rounds,
+                   const unsigned char * in, unsigned char * out, size_t blocks);
+// Encrypts block i under key i on the given engine, for many keys used once each
+void encryptBlocksMultiKey(AesEngine engine, const unsigned char * keys, int keyLength, int rounds,
+                           const unsigned char * in, unsigned char * out, size_t count);
+// CBC-MAC chains blocks into state on the given engine
+void cbcMacBlocks(AesEngine engine, const unsigned char * roundKeys, int rounds,
+                  unsigned char * state, const unsigned char * in, size_t blocks);
+
+#endif
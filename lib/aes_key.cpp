@@ -0,0 +1,136 @@
+/*
+ * aes_key.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Expanded AES key context. The key schedule is computed once
+ * and kept as raw bytes, so any engine or mode can use it
+ * without expanding the key again.
+ */
+
+#ifndef AES_KEY_CPP
+#define AES_KEY_CPP
+
+#include "aes_key.h"
+
+AesKey::AesKey(const unsigned char * key, int keyLength, int rounds):
+    _rounds(rounds ? rounds : standardRounds(keyLength)) {
+    expandKeyBytes(key, keyLength, _rounds, _encryptionKeys);
+    inverseKeyBytes(_encryptionKeys, _rounds, _decryptionKeys);
+}
+
+AesKey::AesKey(const string & key, int rounds):
+    AesKey((const unsigned char *) key.data(), key.size(), rounds) {}
+
+// Round keys for encryption, rounds + 1 blocks of 16 bytes
+const unsigned char * AesKey::encryptionKeys() const{
+    return _encryptionKeys;
+}
+
+// Round keys for the equivalent inverse cipher, in the order decryption uses them
+const unsigned char * AesKey::decryptionKeys() const{
+    return _decryptionKeys;
+}
+
+// Number of rounds the key was expanded for
+int AesKey::rounds() const{
+    return _rounds;
+}
+
+// Reads a 16 byte round key into a matrix, each word of the key is a column
+static QSMatrix<GaloisPolynomial> bytesToMatrix(const unsigned char * key){
+    QSMatrix<GaloisPolynomial> m(4, 4, GaloisPolynomial(0));
+    for(int c=0; c<4; c++){
+        for(int r=0; r<4; r++){
+            m(r,c) = GaloisPolynomial(key[4*c + r]);
+        }
+    }
+    return m;
+}
+
+// Round key i in the matrix form used by the polynomial implementation
+QSMatrix<GaloisPolynomial> AesKey::keyMatrix(int i) const{
+    if(i < 0 || i > _rounds) throw runtime_error("Round key out of range.");
+    return bytesToMatrix(_encryptionKeys + 16*i);
+}
+
+// Equivalent inverse cipher round key i in matrix form
+QSMatrix<GaloisPolynomial> AesKey::inverseKeyMatrix(int i) const{
+    if(i < 0 || i > _rounds) throw runtime_error("Round key out of range.");
+    return bytesToMatrix(_decryptionKeys + 16*i);
+}
+
+AesCompactKey::AesCompactKey(const unsigned char * key, int keyLength, int rounds):
+    _keyLength(keyLength), _rounds(rounds ? rounds : standardRounds(keyLength)) {
+    lastKeyBytes(key, keyLength, _rounds, _lastKey);
+    for(int i=0; i<keyLength; i++){
+        _firstKey[i] = key[i];
+    }
+}
+
+AesCompactKey::AesCompactKey(const string & key, int rounds):
+    AesCompactKey((const unsigned char *) key.data(), key.size(), rounds) {}
+
+// The cipher key, where encryption starts
+const unsigned char * AesCompactKey::firstKey() const{
+    return _firstKey;
+}
+
+// The last words of the schedule, where decryption starts
+const unsigned char * AesCompactKey::lastKey() const{
+    return _lastKey;
+}
+
+// Length of the cipher key in bytes
+int AesCompactKey::keyLength() const{
+    return _keyLength;
+}
+
+// Number of rounds the key is used for
+int AesCompactKey::rounds() const{
+    return _rounds;
+}
+
+// Encrypts consecutive blocks under an expanded key
+void encryptBlocks(AesEngine engine, const AesKey & key, const unsigned char * in, unsigned char * out, size_t blocks){
+    encryptBlocks(engine, key.encryptionKeys(), key.rounds(), in, out, blocks);
+}
+
+// Decrypts consecutive blocks under an expanded key
+void decryptBlocks(AesEngine engine, const AesKey & key, const unsigned char * in, unsigned char * out, size_t blocks){
+    decryptBlocks(engine, key.decryptionKeys(), key.rounds(), in, out, blocks);
+}
+
+// CBC-MAC chains consecutive blocks into a 16 byte state under an expanded key
+void cbcMacBlocks(AesEngine engine, const AesKey & key, unsigned char * state, const unsigned char * in, size_t blocks){
+    cbcMacBlocks(engine, key.encryptionKeys(), key.rounds(), state, in, blocks);
+}
+
+// Encrypts consecutive blocks deriving round keys on the fly
+void encryptBlocks(const AesCompactKey & key, const unsigned char * in, unsigned char * out, size_t blocks){
+    encryptBlocksOnTheFly(key.firstKey(), key.keyLength(), key.rounds(), in, out, blocks);
+}
+
+// Decrypts consecutive blocks deriving round keys on the fly
+void decryptBlocks(const AesCompactKey & key, const unsigned char * in, unsigned char * out, size_t blocks){
+    decryptBlocksOnTheFly(key.lastKey(), key.keyLength(), key.rounds(), in, out, blocks);
+}
+
+// Checks a span pair holds whole blocks and the output has room, returns the block count
+static size_t spanBlocks(ConstByteSpan in, ByteSpan out){
+    if(in.size % AES_BLOCK_SIZE != 0) throw runtime_error("Span must hold whole 16 byte blocks.");
+    if(out.size < in.size) throw runtime_error("Output span is too small.");
+    return in.size / AES_BLOCK_SIZE;
+}
+
+// Encrypts whole blocks into ciphertext without allocating, the spans may be the same buffer
+void encrypt(ConstByteSpan plaintext, ByteSpan ciphertext, const AesKey & key, AesEngine engine){
+    encryptBlocks(engine, key, plaintext.data, ciphertext.data, spanBlocks(plaintext, ciphertext));
+}
+
+// Decrypts whole blocks into plaintext without allocating, the spans may be the same buffer
+void decrypt(ConstByteSpan ciphertext, ByteSpan plaintext, const AesKey & key, AesEngine engine){
+    decryptBlocks(engine, key, ciphertext.data, plaintext.data, spanBlocks(ciphertext, plaintext));
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * aes_key.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Expanded AES key context. The key schedule is computed once
+ * and kept as raw bytes, so any engine or mode can use it
+ * without expanding the key again.
+ */
+
+#ifndef AES_KEY_H
+#define AES_KEY_H
+
+#include "aes_engine.h"
+#include "byte_span.h"
+#include "galois_field.h"
+#include "matrix.h"
+#include <string>
+
+using std::string;
+
+/*
+ * AesKey
+ * Holds the encryption round keys and the equivalent inverse
+ * cipher round keys, 16 byte aligned for vector loads. Nothing
+ * is modified after construction, so one key may be shared read
+ * only between threads. Zero rounds picks the FIPS-197 count for
+ * the key length.
+ */
+class AesKey{
+public:
+    AesKey(const unsigned char * key, int keyLength, int rounds = 0);
+    explicit AesKey(const string & key, int rounds = 0);
+    
+    // Round keys for encryption, rounds + 1 blocks of 16 bytes
+    const unsigned char * encryptionKeys() const;
+    // Round keys for the equivalent inverse cipher, in the order decryption uses them
+    const unsigned char * decryptionKeys() const;
+    // Number of rounds the key was expanded for
+    int rounds() const;
+    
+    // Round key i in the matrix form used by the polynomial implementation
+    QSMatrix<GaloisPolynomial> keyMatrix(int i) const;
+    // Equivalent inverse cipher round key i in matrix form
+    QSMatrix<GaloisPolynomial> inverseKeyMatrix(int i) const;
+    
+private:
+    alignas(16) unsigned char _encryptionKeys[AES_BLOCK_SIZE*(AES_MAX_ROUNDS+1)];
+    alignas(16) unsigned char _decryptionKeys[AES_BLOCK_SIZE*(AES_MAX_ROUNDS+1)];
+    int _rounds;
+};
+
+/*
+ * AesCompactKey
+ * Holds only the cipher key and the last key length of the
+ * schedule, at most 64 bytes against 480 for AesKey. Round keys
+ * are derived as each round starts, forwards for encryption and
+ * backwards for decryption.
+ */
+class AesCompactKey{
+public:
+    AesCompactKey(const unsigned char * key, int keyLength, int rounds = 0);
+    explicit AesCompactKey(const string & key, int rounds = 0);
+    
+    // The cipher key, where encryption starts
+    const unsigned char * firstKey() const;
+    // The last words of the schedule, where decryption starts
+    const unsigned char * lastKey() const;
+    // Length of the cipher key in bytes
+    int keyLength() const;
+    // Number of rounds the key is used for
+    int rounds() const;
+    
+private:
+    unsigned char _firstKey[32];
+    unsigned char _lastKey[32];
+    int _keyLength;
+    int _rounds;
+};
+
+// Encrypts consecutive blocks under an expanded key
+void encryptBlocks(AesEngine engine, const AesKey & key, const unsigned char * in, unsigned char * out, size_t blocks);
+// Decrypts consecutive blocks under an expanded key
+void decryptBlocks(AesEngine engine, const AesKey & key, const unsigned char * in, unsigned char * out, size_t blocks);
+// CBC-MAC chains consecutive blocks into a 16 byte state under an expanded key
+void cbcMacBlocks(AesEngine engine, const AesKey & key, unsigned char * state, const unsigned char * in, size_t blocks);
+// Encrypts consecutive blocks deriving round keys on the fly
+void encryptBlocks(const AesCompactKey & key, const unsigned char * in, unsigned char * out, size_t blocks);
+// Decrypts consecutive blocks deriving round keys on the fly
+void decryptBlocks(const AesCompactKey & key, const unsigned char * in, unsigned char * out, size_t blocks);
+
+// Encrypts whole blocks into ciphertext without allocating, the spans may be the same buffer
+void encrypt(ConstByteSpan plaintext, ByteSpan ciphertext, const AesKey & key, AesEngine engine = ENGINE_AUTO);
+// Decrypts whole blocks into plaintext without allocating, the spans may be the same buffer
+void decrypt(ConstByteSpan ciphertext, ByteSpan plaintext, const AesKey & key, AesEngine engine = ENGINE_AUTO);
+
+#endif
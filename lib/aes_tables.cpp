@@ -0,0 +1,108 @@
+/*
+ * aes_tables.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Byte level lookup tables for the Rijndael round function.
+ * Every entry is computed once from the polynomial
+ * implementation in aes.h, so the fast engines are derived
+ * from the same math as the reference implementation.
+ */
+
+#ifndef AES_TABLES_CPP
+#define AES_TABLES_CPP
+
+#include "aes_tables.h"
+#include "aes.h"
+#include <atomic>
+
+// Tables installed in place of building them, see installAesTables
+static const AesTables * installedTables = nullptr;
+static std::atomic<bool> tablesUsed(false);
+
+/*
+ * SavedModuli
+ * Holds the calling thread's moduli and puts them back when it goes
+ * out of scope, so building the tables leaves the caller's field alone.
+ */
+class SavedModuli{
+public:
+    SavedModuli(): _field(GaloisPolynomial::globalModulus()), _prime(Modular<int>::globalModulus()) {}
+    
+    ~SavedModuli(){
+        GaloisPolynomial::globalSetModulus(_field);
+        Modular<int>::globalSetModulus(_prime);
+    }
+
+private:
+    Polynomial _field;
+    int _prime;
+};
+
+// Evaluate the S-Boxes and the columns of M and M_inverse for every byte
+AesTables buildAesTables(){
+    AesTables t;
+    
+    SavedModuli saved;
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    Modular<int>::globalSetModulus(2);
+    for(int x=0; x<256; x++){
+        GaloisPolynomial p(x);
+        t.sbox[x] = polyToChar(sBox(p));
+        GaloisPolynomial q(x);
+        t.sbox_inverse[x] = polyToChar(sBox_inverse(q));
+    }
+    
+    for(int x=0; x<256; x++){
+        GaloisPolynomial s(t.sbox[x]);
+        for(int r=0; r<4; r++){
+            uint32_t word = 0;
+            for(int i=0; i<4; i++){
+                word |= (uint32_t) polyToChar(rijndael_M(i,r) * s) << (24 - 8*i);
+            }
+            t.te[r][x] = word;
+        }
+    }
+    
+    for(int x=0; x<256; x++){
+        GaloisPolynomial s(t.sbox_inverse[x]);
+        for(int r=0; r<4; r++){
+            uint32_t word = 0;
+            for(int i=0; i<4; i++){
+                word |= (uint32_t) polyToChar(rijndael_M_inverse(i,r) * s) << (24 - 8*i);
+            }
+            t.td[r][x] = word;
+        }
+    }
+    
+    t.rcon[0] = 0;
+    t.rcon[1] = 1;
+    for(int j=2; j<16; j++){
+        t.rcon[j] = xtime(t.rcon[j-1]);
+    }
+    
+    return t;
+}
+
+// Picks the installed tables or builds them, once, and stops later installs
+static const AesTables & selectTables(){
+    tablesUsed = true;
+    if(installedTables != nullptr) return *installedTables;
+    static const AesTables built = buildAesTables();
+    return built;
+}
+
+// Returns the tables, building them from the Rijndael field on first use unless others were installed
+const AesTables & aesTables(){
+    static const AesTables & tables = selectTables();
+    return tables;
+}
+
+// Makes aesTables() return tables from elsewhere, such as a mapped file. Must be called before its
+// first use, and the tables must outlive every engine call
+void installAesTables(const AesTables & tables){
+    if(tablesUsed) throw runtime_error("AES tables are already in use.");
+    installedTables = &tables;
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * aes_tables.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Byte level lookup tables for the Rijndael round function.
+ * Every entry is computed once from the polynomial
+ * implementation in aes.h, so the fast engines are derived
+ * from the same math as the reference implementation.
+ */
+
+#ifndef AES_TABLES_H
+#define AES_TABLES_H
+
+#include <cstdint>
+
+using std::uint32_t;
+
+/*
+ * AesTables
+ * S-Box lookups and the fused S-Box/mix columns tables. Column
+ * words are packed big endian, row 0 of the state in the top byte.
+ */
+struct AesTables{
+    // S-Box and inverse S-Box as byte lookups
+    unsigned char sbox[256];
+    unsigned char sbox_inverse[256];
+    // te[r][x] is column r of M times S(x), one column of mix columns
+    uint32_t te[4][256];
+    // td[r][x] is column r of M_inverse times S_inverse(x), for the equivalent inverse cipher
+    uint32_t td[4][256];
+    // rcon[j] is x^(j-1), the key schedule round constants
+    unsigned char rcon[16];
+};
+
+// Returns the tables, building them from the Rijndael field on first use unless others were installed
+const AesTables & aesTables();
+// Evaluates every table from the Rijndael field, without caching the result or changing the caller's moduli
+AesTables buildAesTables();
+// Makes aesTables() return tables from elsewhere, such as a mapped file. Must be called before its
+// first use, and the tables must outlive every engine call
+void installAesTables(const AesTables & tables);
+
+// Multiply a byte by x in the Rijndael field
+inline unsigned char xtime(unsigned char b){
+    return (unsigned char) ((b << 1) ^ ((b >> 7) * 0x1b));
+}
+
+// Multiply two bytes in the Rijndael field by shift and add
+inline unsigned char multiplyBytes(unsigned char a, unsigned char b){
+    unsigned char p = 0;
+    while(b != 0){
+        if(b & 1) p ^= a;
+        a = xtime(a);
+        b >>= 1;
+    }
+    return p;
+}
+
+#endif
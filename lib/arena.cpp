@@ -0,0 +1,103 @@
+/*
+ * arena.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Per thread monotonic arena for the temporaries of the
+ * polynomial implementation.
+ */
+
+#ifndef ARENA_CPP
+#define ARENA_CPP
+
+#include "arena.h"
+
+// Size of the first block, later blocks double
+static const size_t firstBlockSize = 64 * 1024;
+
+// Open ArenaScopes and ArenaSuspends on this thread, arena allocation is on inside a scope unless suspended
+static thread_local int scopeDepth = 0;
+static thread_local int suspendDepth = 0;
+
+Arena::Arena(): _current(0), _used(0) {}
+
+Arena::~Arena(){
+    for(size_t i=0; i<_blocks.size(); i++){
+        ::operator delete(_blocks[i].data);
+    }
+}
+
+// Memory for bytes with the given alignment
+void * Arena::allocate(size_t bytes, size_t alignment){
+    while(true){
+        if(_current < _blocks.size()){
+            Block & block = _blocks[_current];
+            size_t offset = (_used + alignment - 1) & ~(alignment - 1);
+            if(offset <= block.size && bytes <= block.size - offset){
+                _used = offset + bytes;
+                return block.data + offset;
+            }
+            // Move on to a later block that is already there
+            if(_current + 1 < _blocks.size()){
+                _current++;
+                _used = 0;
+                continue;
+            }
+        }
+        grow(bytes + alignment);
+    }
+}
+
+// Makes every block free again, merging them into one if there are several
+void Arena::reset(){
+    if(_blocks.size() > 1){
+        size_t total = 0;
+        for(size_t i=0; i<_blocks.size(); i++){
+            total += _blocks[i].size;
+            ::operator delete(_blocks[i].data);
+        }
+        _blocks.clear();
+        grow(total);
+    }
+    _current = 0;
+    _used = 0;
+}
+
+// Adds a block with room for at least bytes
+void Arena::grow(size_t bytes){
+    size_t size = _blocks.empty() ? firstBlockSize : 2 * _blocks.back().size;
+    if(size < bytes) size = bytes;
+    Block block = { (unsigned char *) ::operator new(size), size };
+    _blocks.push_back(block);
+    _current = _blocks.size() - 1;
+    _used = 0;
+}
+
+// The calling thread's arena
+Arena & threadArena(){
+    static thread_local Arena arena;
+    return arena;
+}
+
+// Whether allocations on this thread currently come from its arena
+bool arenaActive(){
+    return scopeDepth > 0 && suspendDepth == 0;
+}
+
+ArenaScope::ArenaScope(){
+    scopeDepth++;
+}
+
+ArenaScope::~ArenaScope(){
+    if(--scopeDepth == 0) threadArena().reset();
+}
+
+ArenaSuspend::ArenaSuspend(){
+    suspendDepth++;
+}
+
+ArenaSuspend::~ArenaSuspend(){
+    suspendDepth--;
+}
+
+#endif
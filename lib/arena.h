@@ -0,0 +1,149 @@
+/*
+ * arena.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Per thread monotonic arena for the temporaries of the
+ * polynomial implementation. While an ArenaScope is open on a
+ * thread, Polynomial and QSMatrix storage is carved from that
+ * thread's arena and frees cost nothing; the whole arena is
+ * reset when the outermost scope closes.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+using std::size_t;
+using std::vector;
+
+/*
+ * Arena
+ * Hands out memory from a list of blocks by bumping an offset.
+ * Nothing is returned until reset, which keeps one block large
+ * enough for everything used so the next pass needs no new blocks.
+ */
+class Arena{
+public:
+    Arena();
+    ~Arena();
+    Arena(const Arena &) = delete;
+    Arena & operator=(const Arena &) = delete;
+    
+    // Memory for bytes with the given alignment
+    void * allocate(size_t bytes, size_t alignment);
+    // Makes every block free again
+    void reset();
+
+private:
+    struct Block{
+        unsigned char * data;
+        size_t size;
+    };
+    
+    // Adds a block with room for at least bytes
+    void grow(size_t bytes);
+    
+    vector<Block> _blocks;
+    size_t _current;    // Block being carved
+    size_t _used;       // Bytes used in the current block
+};
+
+// The calling thread's arena
+Arena & threadArena();
+// Whether allocations on this thread currently come from its arena
+bool arenaActive();
+
+/*
+ * ArenaHeader
+ * Precedes every ArenaAllocator allocation. Heap allocations have no
+ * owner and carry ARENA_HEAP_MARK, which arena memory reused after a
+ * reset is all but certain not to repeat.
+ */
+struct ArenaHeader{
+    Arena * owner;      // Arena the memory came from, nullptr for the heap
+    uint64_t mark;      // ARENA_HEAP_MARK for the heap, 0 for an arena
+};
+
+static const uint64_t ARENA_HEAP_MARK = 0x9e3779b97f4a7c15ULL;
+
+/*
+ * ArenaScope
+ * Routes arena allocations on this thread to its arena for its
+ * lifetime. Scopes nest, and the arena is reset when the outermost
+ * one closes, so nothing allocated inside may outlive it.
+ */
+class ArenaScope{
+public:
+    ArenaScope();
+    ~ArenaScope();
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope & operator=(const ArenaScope &) = delete;
+};
+
+/*
+ * ArenaSuspend
+ * Sends allocations back to the heap inside an ArenaScope, for
+ * objects such as global moduli that outlive the call.
+ */
+class ArenaSuspend{
+public:
+    ArenaSuspend();
+    ~ArenaSuspend();
+    ArenaSuspend(const ArenaSuspend &) = delete;
+    ArenaSuspend & operator=(const ArenaSuspend &) = delete;
+};
+
+/*
+ * ArenaAllocator
+ * Standard allocator that uses the thread's arena inside an
+ * ArenaScope and the heap otherwise. Each allocation is preceded
+ * by a header naming the arena it came from, or marking it as heap
+ * memory, so whichever thread frees it only heap memory is returned
+ * to the heap. Arena memory must still not be used once its scope
+ * has closed.
+ */
+template<typename T>
+struct ArenaAllocator{
+    typedef T value_type;
+    
+    // Room for the header before each allocation, keeping the allocation aligned
+    static const size_t HEADER = alignof(std::max_align_t);
+    static_assert(alignof(T) <= HEADER, "ArenaAllocator does not support over-aligned types.");
+    static_assert(sizeof(ArenaHeader) <= HEADER, "ArenaHeader must fit before the allocation.");
+    
+    ArenaAllocator() {}
+    template<typename U> ArenaAllocator(const ArenaAllocator<U> &) {}
+    
+    T * allocate(size_t n){
+        ArenaHeader * header;
+        if(arenaActive()){
+            Arena & arena = threadArena();
+            header = (ArenaHeader *) arena.allocate(HEADER + n * sizeof(T), HEADER);
+            header->owner = &arena;
+            header->mark = 0;
+        }
+        else{
+            header = (ArenaHeader *) ::operator new(HEADER + n * sizeof(T));
+            header->owner = nullptr;
+            header->mark = ARENA_HEAP_MARK;
+        }
+        return (T *) ((unsigned char *) header + HEADER);
+    }
+    
+    void deallocate(T * p, size_t){
+        ArenaHeader * header = (ArenaHeader *) ((unsigned char *) p - HEADER);
+        if(header->owner == nullptr && header->mark == ARENA_HEAP_MARK) ::operator delete(header);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T> &, const ArenaAllocator<U> &){ return true; }
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &, const ArenaAllocator<U> &){ return false; }
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * batch_service.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Asynchronous encryption of many small independent records.
+ * Jobs are queued and run in batches on a work stealing pool,
+ * and report back through a future or a callback.
+ */
+
+#ifndef BATCH_SERVICE_CPP
+#define BATCH_SERVICE_CPP
+
+#include "batch_service.h"
+#include <cstring>
+
+BatchService::BatchService(int threads, AesEngine engine, size_t batchBytes):
+    _engine(engine), _batchBytes(batchBytes), _draining(0), _pool(threads) {}
+
+BatchService::~BatchService(){
+    // The pool destructor runs the drain tasks, which empty the queue
+}
+
+// Queues a job, the future holds false if a GCM tag did not match
+std::future<bool> BatchService::submit(const BatchJob & job){
+    Pending p;
+    p.job = job;
+    p.result = std::make_shared<std::promise<bool>>();
+    std::future<bool> f = p.result->get_future();
+    enqueue(std::move(p));
+    return f;
+}
+
+// Queues a job, done is called from a worker with false if it failed
+void BatchService::submit(const BatchJob & job, function<void(bool)> done){
+    Pending p;
+    p.job = job;
+    p.done = std::move(done);
+    enqueue(std::move(p));
+}
+
+// Queues a pending job and starts a drain task if a worker is free
+void BatchService::enqueue(Pending p){
+    bool start = false;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _queue.push_back(std::move(p));
+        if(_draining < _pool.threadCount()){
+            _draining++;
+            start = true;
+        }
+    }
+    if(start) _pool.submit([this](){ drain(); });
+}
+
+// Takes queued jobs up to batchBytes and runs them as one batch
+void BatchService::drain(){
+    vector<Pending> batch;
+    size_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        while(!_queue.empty() && bytes < _batchBytes){
+            bytes += _queue.front().job.data.size;
+            batch.push_back(std::move(_queue.front()));
+            _queue.pop_front();
+        }
+    }
+    runBatch(batch);
+    
+    // A full batch gives the worker back, another drain task picks up the rest
+    std::lock_guard<std::mutex> lock(_lock);
+    if(_queue.empty()) _draining--;
+    else _pool.submit([this](){ drain(); });
+}
+
+// Whether a job is a short whole block job that can share an engine call with others under its key
+static bool gatherable(const BatchJob & job){
+    return (job.mode == BATCH_ENCRYPT || job.mode == BATCH_DECRYPT) && job.key
+        && job.data.size != 0 && job.data.size % 16 == 0 && job.data.size < 16*BATCH_GATHER_BLOCKS;
+}
+
+// Runs a batch. Short block jobs under one key and direction are copied together and run as one
+// engine call, so the interleaved lanes stay full; every other job runs in place on its own
+void BatchService::runBatch(vector<Pending> & batch) const{
+    vector<bool> finished(batch.size(), false);
+    vector<unsigned char> gathered;
+    for(size_t i=0; i<batch.size(); i++){
+        if(finished[i] || !gatherable(batch[i].job)) continue;
+        const BatchJob & first = batch[i].job;
+        vector<size_t> group;
+        gathered.clear();
+        for(size_t j=i; j<batch.size(); j++){
+            const BatchJob & job = batch[j].job;
+            if(finished[j] || !gatherable(job) || job.mode != first.mode || job.key != first.key) continue;
+            group.push_back(j);
+            gathered.insert(gathered.end(), job.data.data, job.data.data + job.data.size);
+        }
+        if(group.size() == 1) continue;
+        
+        // A failed call leaves the group to run one job at a time, each reporting its own error
+        try{
+            if(first.mode == BATCH_ENCRYPT) encryptBlocks(_engine, *first.key, gathered.data(), gathered.data(), gathered.size() / 16);
+            else decryptBlocks(_engine, *first.key, gathered.data(), gathered.data(), gathered.size() / 16);
+        }
+        catch(...){
+            continue;
+        }
+        
+        const unsigned char * next = gathered.data();
+        for(size_t g=0; g<group.size(); g++){
+            Pending & p = batch[group[g]];
+            memcpy(p.job.data.data, next, p.job.data.size);
+            next += p.job.data.size;
+            if(p.result) p.result->set_value(true);
+            callBack(p, true);
+            finished[group[g]] = true;
+        }
+    }
+    
+    for(size_t i=0; i<batch.size(); i++){
+        if(!finished[i]) runOne(batch[i]);
+    }
+}
+
+// Runs one job in place and reports its result
+void BatchService::runOne(Pending & p) const{
+    bool ok = false;
+    try{
+        ok = runJob(p.job);
+        if(p.result) p.result->set_value(ok);
+    }
+    catch(...){
+        if(p.result) p.result->set_exception(std::current_exception());
+    }
+    callBack(p, ok);
+}
+
+// Calls a job's callback, which has no caller to throw to, so its exceptions are dropped
+void BatchService::callBack(Pending & p, bool ok){
+    if(!p.done) return;
+    try{
+        p.done(ok);
+    }
+    catch(...){}
+}
+
+// Runs one job, returns false if a GCM tag did not match
+bool BatchService::runJob(const BatchJob & job) const{
+    switch(job.mode){
+        case BATCH_ENCRYPT:
+            if(!job.key) throw runtime_error("Block job needs a key.");
+            encrypt(job.data, job.data, *job.key, _engine);
+            return true;
+        case BATCH_DECRYPT:
+            if(!job.key) throw runtime_error("Block job needs a key.");
+            decrypt(job.data, job.data, *job.key, _engine);
+            return true;
+        case BATCH_GCM_ENCRYPT:
+            if(!job.gcm || job.tag == nullptr) throw runtime_error("GCM job needs a context and a tag.");
+            job.gcm->encrypt(job.iv.data, job.iv.size, job.aad.data, job.aad.size,
+                             job.data.data, job.data.data, job.data.size, job.tag);
+            return true;
+        case BATCH_GCM_DECRYPT:
+            if(!job.gcm || job.tag == nullptr) throw runtime_error("GCM job needs a context and a tag.");
+            return job.gcm->decrypt(job.iv.data, job.iv.size, job.aad.data, job.aad.size,
+                                    job.data.data, job.data.data, job.data.size, job.tag);
+    }
+    throw runtime_error("Unknown batch mode.");
+}
+
+#endif
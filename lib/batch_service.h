@@ -0,0 +1,106 @@
+/*
+ * batch_service.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Asynchronous encryption of many small independent records.
+ * Jobs are queued and run in batches on a work stealing pool,
+ * and report back through a future or a callback.
+ */
+
+#ifndef BATCH_SERVICE_H
+#define BATCH_SERVICE_H
+
+#include "aes_key.h"
+#include "gcm.h"
+#include "thread_pool.h"
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using std::shared_ptr;
+
+// What a job does to its buffer
+enum BatchMode{
+    BATCH_ENCRYPT,      // Encrypt whole blocks under key
+    BATCH_DECRYPT,      // Decrypt whole blocks under key
+    BATCH_GCM_ENCRYPT,  // GCM encrypt under gcm, writing tag
+    BATCH_GCM_DECRYPT   // GCM decrypt under gcm, checking tag
+};
+
+/*
+ * BatchJob
+ * One record. The buffer is processed in place, and it and the
+ * iv, aad and tag must stay alive until the job completes. The
+ * key contexts are shared so a record may outlive its caller's
+ * reference.
+ */
+struct BatchJob{
+    BatchMode mode;
+    shared_ptr<const AesKey> key;   // Used by the block modes
+    shared_ptr<const Gcm> gcm;      // Used by the GCM modes
+    ByteSpan data;
+    ConstByteSpan iv;
+    ConstByteSpan aad;
+    unsigned char * tag;            // 16 bytes, written or checked by the GCM modes
+    
+    BatchJob(): mode(BATCH_ENCRYPT), tag(nullptr) {}
+};
+
+// Block jobs shorter than this many blocks are gathered with others under the same key
+const size_t BATCH_GATHER_BLOCKS = 8;
+
+/*
+ * BatchService
+ * Queued jobs are taken by up to one drain task per worker. A
+ * drain task takes jobs up to batchBytes, runs them, then hands
+ * the worker back, so a lightly loaded service runs each job as
+ * soon as it arrives and a busy one runs them in large batches.
+ * Within a batch, short block jobs sharing a key and direction
+ * are copied together into one engine call. Only the byte
+ * engines run here, never the polynomial implementation.
+ * 
+ * A callback that throws has its exception dropped.
+ */
+class BatchService{
+public:
+    explicit BatchService(int threads = 0, AesEngine engine = ENGINE_AUTO, size_t batchBytes = 64 << 10);
+    // Waits for every submitted job to complete
+    ~BatchService();
+    
+    // Queues a job, the future holds false if a GCM tag did not match
+    std::future<bool> submit(const BatchJob & job);
+    // Queues a job, done is called from a worker with false if it failed
+    void submit(const BatchJob & job, function<void(bool)> done);
+    
+private:
+    struct Pending{
+        BatchJob job;
+        function<void(bool)> done;
+        shared_ptr<std::promise<bool>> result;
+    };
+    
+    // Queues a pending job and starts a drain task if a worker is free
+    void enqueue(Pending p);
+    // Takes queued jobs up to batchBytes and runs them as one batch
+    void drain();
+    // Runs a batch, gathering short block jobs under a shared key into one engine call
+    void runBatch(vector<Pending> & batch) const;
+    // Runs one job in place and reports its result
+    void runOne(Pending & p) const;
+    // Calls a job's callback, dropping anything it throws
+    static void callBack(Pending & p, bool ok);
+    // Runs one job, returns false if a GCM tag did not match
+    bool runJob(const BatchJob & job) const;
+    
+    AesEngine _engine;
+    size_t _batchBytes;
+    std::mutex _lock;
+    std::deque<Pending> _queue;
+    int _draining;          // Drain tasks queued or running, guarded by _lock
+    ThreadPool _pool;       // Last, so it finishes every task before the rest is destroyed
+};
+
+#endif
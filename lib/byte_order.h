@@ -0,0 +1,83 @@
+/*
+ * byte_order.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Loads and stores of 64 bit words in a fixed byte order,
+ * and word at a time xor of byte buffers.
+ */
+
+#ifndef BYTE_ORDER_H
+#define BYTE_ORDER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+using std::uint64_t;
+using std::size_t;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define AES_LITTLE_ENDIAN 1
+#endif
+
+// Read 8 bytes as a little endian integer
+inline uint64_t loadLittle64(const unsigned char * p){
+#ifdef AES_LITTLE_ENDIAN
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+#else
+    return (uint64_t) p[0] | ((uint64_t) p[1] << 8) | ((uint64_t) p[2] << 16) | ((uint64_t) p[3] << 24)
+         | ((uint64_t) p[4] << 32) | ((uint64_t) p[5] << 40) | ((uint64_t) p[6] << 48) | ((uint64_t) p[7] << 56);
+#endif
+}
+
+// Write an integer as 8 little endian bytes
+inline void storeLittle64(unsigned char * p, uint64_t v){
+#ifdef AES_LITTLE_ENDIAN
+    std::memcpy(p, &v, 8);
+#else
+    for(int i=0; i<8; i++){
+        p[i] = (unsigned char) (v >> (8*i));
+    }
+#endif
+}
+
+// Read 8 bytes as a big endian integer
+inline uint64_t loadBig64(const unsigned char * p){
+#ifdef AES_LITTLE_ENDIAN
+    return __builtin_bswap64(loadLittle64(p));
+#else
+    return ((uint64_t) p[0] << 56) | ((uint64_t) p[1] << 48) | ((uint64_t) p[2] << 40) | ((uint64_t) p[3] << 32)
+         | ((uint64_t) p[4] << 24) | ((uint64_t) p[5] << 16) | ((uint64_t) p[6] << 8) | (uint64_t) p[7];
+#endif
+}
+
+// Write an integer as 8 big endian bytes
+inline void storeBig64(unsigned char * p, uint64_t v){
+#ifdef AES_LITTLE_ENDIAN
+    storeLittle64(p, __builtin_bswap64(v));
+#else
+    for(int i=0; i<8; i++){
+        p[i] = (unsigned char) (v >> (56 - 8*i));
+    }
+#endif
+}
+
+// Sets out = a ^ b over length bytes, a word at a time while possible
+inline void xorBytes(unsigned char * out, const unsigned char * a, const unsigned char * b, size_t length){
+    size_t i = 0;
+    for(; i+8<=length; i+=8){
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        x ^= y;
+        std::memcpy(out + i, &x, 8);
+    }
+    for(; i<length; i++){
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+#endif
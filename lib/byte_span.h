@@ -0,0 +1,76 @@
+/*
+ * byte_span.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Non owning views of byte buffers, so callers can pass
+ * strings, vectors or raw memory without copying them, and
+ * reading bytes written as hex.
+ */
+
+#ifndef BYTE_SPAN_H
+#define BYTE_SPAN_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::size_t;
+using std::runtime_error;
+using std::string;
+using std::vector;
+
+/*
+ * ByteSpan
+ * A pointer and length over writable bytes owned elsewhere. The
+ * viewed buffer must outlive the span.
+ */
+struct ByteSpan{
+    unsigned char * data;
+    size_t size;
+    
+    ByteSpan(): data(nullptr), size(0) {}
+    ByteSpan(unsigned char * d, size_t n): data(d), size(n) {}
+    ByteSpan(string & s): data((unsigned char *) &s[0]), size(s.size()) {}
+    ByteSpan(vector<unsigned char> & v): data(v.data()), size(v.size()) {}
+    
+    // The n bytes starting at offset
+    ByteSpan subspan(size_t offset, size_t n) const{
+        if(offset > size || n > size - offset) throw runtime_error("Span out of range.");
+        return ByteSpan(data + offset, n);
+    }
+};
+
+/*
+ * ConstByteSpan
+ * A pointer and length over read only bytes owned elsewhere.
+ */
+struct ConstByteSpan{
+    const unsigned char * data;
+    size_t size;
+    
+    ConstByteSpan(): data(nullptr), size(0) {}
+    ConstByteSpan(const unsigned char * d, size_t n): data(d), size(n) {}
+    ConstByteSpan(const string & s): data((const unsigned char *) s.data()), size(s.size()) {}
+    ConstByteSpan(const vector<unsigned char> & v): data(v.data()), size(v.size()) {}
+    ConstByteSpan(ByteSpan s): data(s.data), size(s.size) {}
+    
+    // The n bytes starting at offset
+    ConstByteSpan subspan(size_t offset, size_t n) const{
+        if(offset > size || n > size - offset) throw runtime_error("Span out of range.");
+        return ConstByteSpan(data + offset, n);
+    }
+};
+
+// Converts a hex string to bytes, an odd number of digits is an error
+inline vector<unsigned char> fromHex(const string & hex){
+    if(hex.size() % 2 != 0) throw runtime_error("Hex must be an even number of digits.");
+    vector<unsigned char> bytes;
+    for(size_t i=0; i<hex.size(); i+=2){
+        bytes.push_back((unsigned char) std::stoi(hex.substr(i, 2), nullptr, 16));
+    }
+    return bytes;
+}
+
+#endif
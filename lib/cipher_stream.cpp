@@ -0,0 +1,182 @@
+/*
+ * cipher_stream.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Incremental ECB, CBC (NIST SP 800-38A) and CTR over input
+ * arriving in pieces of any size. Whole blocks are run straight
+ * from the caller's buffers; only a partial block, or the unused
+ * part of a CTR keystream block, is held between calls, so a
+ * stream is under 64 bytes and many can be open at once.
+ */
+
+#ifndef CIPHER_STREAM_CPP
+#define CIPHER_STREAM_CPP
+
+#include "cipher_stream.h"
+#include "byte_order.h"
+#include <cstring>
+
+// Blocks of CBC ciphertext or CTR keystream handled per engine call
+static const size_t STREAM_CHUNK_BLOCKS = 32;
+
+// Increment a 16 byte big endian counter block, a word at a time
+static inline void incrementCounter(unsigned char * counter){
+    uint64_t low = loadBig64(counter + 8) + 1;
+    storeBig64(counter + 8, low);
+    if(low == 0) storeBig64(counter, loadBig64(counter) + 1);
+}
+
+CipherStream::CipherStream(const AesKey & key, CipherMode mode, bool encrypting,
+                           const unsigned char * iv, AesEngine engine):
+    _key(key), _engine(resolveEngine(engine)), _mode(mode), _encrypting(encrypting) {
+    reset(iv);
+}
+
+// Adds length bytes of input, returns the bytes written to out, at most length + 15
+size_t CipherStream::update(const unsigned char * in, size_t length, unsigned char * out){
+    if(_mode == MODE_CTR){
+        cryptCounter(in, out, length);
+        return length;
+    }
+    
+    // Top up a held block first, it is run from the stream's own copy
+    size_t written = 0;
+    if(_used != 0){
+        size_t take = 16 - _used;
+        if(take > length) take = length;
+        memcpy(_block + _used, in, take);
+        _used += take;
+        in += take;
+        length -= take;
+        if(_used < 16) return 0;
+        
+        cryptBlocks(_block, out, 1);
+        out += 16;
+        written = 16;
+        _used = 0;
+    }
+    
+    // Whole blocks go straight from in to out, the rest waits for more input
+    size_t blocks = length / 16;
+    cryptBlocks(in, out, blocks);
+    memcpy(_block, in + 16*blocks, length % 16);
+    _used = length % 16;
+    return written + 16*blocks;
+}
+
+// Writes what is held back, at most 16 bytes, and returns its length, reset starts the next message
+size_t CipherStream::finalize(unsigned char * out){
+    if(_mode == MODE_CTR || _used == 0){
+        _used = 0;
+        return 0;
+    }
+    if(!_encrypting){
+        _used = 0;
+        throw runtime_error("Ciphertext must be whole 16 byte blocks.");
+    }
+    
+    // Zero pad the last block, as encrypt() in aes.h does
+    memset(_block + _used, 0, 16 - _used);
+    cryptBlocks(_block, out, 1);
+    _used = 0;
+    return 16;
+}
+
+// Drops any input and starts a new message, with a new iv for CBC and CTR
+void CipherStream::reset(const unsigned char * iv){
+    _used = 0;
+    if(_mode == MODE_ECB) return;
+    if(iv == nullptr) throw runtime_error("CBC and CTR need a 16 byte iv.");
+    memcpy(_chain, iv, 16);
+}
+
+// Bytes of input held until more arrives
+size_t CipherStream::buffered() const{
+    return _mode == MODE_CTR ? 0 : _used;
+}
+
+// Runs whole blocks from in to out, chaining or counting as the mode needs
+void CipherStream::cryptBlocks(const unsigned char * in, unsigned char * out, size_t blocks){
+    if(blocks == 0) return;
+    
+    if(_mode == MODE_ECB){
+        if(_encrypting) encryptBlocks(_engine, _key, in, out, blocks);
+        else decryptBlocks(_engine, _key, in, out, blocks);
+        return;
+    }
+    
+    // Encryption chains through every block, so it goes one at a time
+    if(_encrypting){
+        for(size_t b=0; b<blocks; b++){
+            xorBytes(_chain, _chain, in + 16*b, 16);
+            encryptBlocks(_engine, _key, _chain, _chain, 1);
+            memcpy(out + 16*b, _chain, 16);
+        }
+        return;
+    }
+    
+    // Decryption is independent per block, only decrypting in place needs the ciphertext kept aside
+    unsigned char saved[16*STREAM_CHUNK_BLOCKS];
+    while(blocks > 0){
+        size_t n = blocks < STREAM_CHUNK_BLOCKS ? blocks : STREAM_CHUNK_BLOCKS;
+        const unsigned char * cipher = in;
+        if(in == out){
+            memcpy(saved, in, 16*n);
+            cipher = saved;
+        }
+        decryptBlocks(_engine, _key, cipher, out, n);
+        xorBytes(out, out, _chain, 16);
+        xorBytes(out + 16, out + 16, cipher, 16*(n - 1));
+        memcpy(_chain, cipher + 16*(n - 1), 16);
+        
+        in += 16*n;
+        out += 16*n;
+        blocks -= n;
+    }
+}
+
+// Runs length bytes through the counter keystream, keeping the unused part of its last block
+void CipherStream::cryptCounter(const unsigned char * in, unsigned char * out, size_t length){
+    // Finish the keystream block the last call started
+    if(_used != 0){
+        size_t take = 16 - _used;
+        if(take > length) take = length;
+        xorBytes(out, in, _block + _used, take);
+        _used = (_used + take) % 16;
+        in += take;
+        out += take;
+        length -= take;
+    }
+    
+    // The counter is held as two words while whole blocks are laid out
+    unsigned char keystream[16*STREAM_CHUNK_BLOCKS];
+    uint64_t high = loadBig64(_chain), low = loadBig64(_chain + 8);
+    while(length >= 16){
+        size_t n = length / 16;
+        if(n > STREAM_CHUNK_BLOCKS) n = STREAM_CHUNK_BLOCKS;
+        for(size_t b=0; b<n; b++){
+            storeBig64(keystream + 16*b, high);
+            storeBig64(keystream + 16*b + 8, low);
+            if(++low == 0) high++;
+        }
+        encryptBlocks(_engine, _key, keystream, keystream, n);
+        xorBytes(out, in, keystream, 16*n);
+        
+        in += 16*n;
+        out += 16*n;
+        length -= 16*n;
+    }
+    storeBig64(_chain, high);
+    storeBig64(_chain + 8, low);
+    
+    // A partial block leaves the rest of its keystream for the next call
+    if(length != 0){
+        encryptBlocks(_engine, _key, _chain, _block, 1);
+        incrementCounter(_chain);
+        xorBytes(out, in, _block, length);
+        _used = length;
+    }
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * cipher_stream.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Incremental ECB, CBC (NIST SP 800-38A) and CTR over input
+ * arriving in pieces of any size. Whole blocks are run straight
+ * from the caller's buffers; only a partial block, or the unused
+ * part of a CTR keystream block, is held between calls, so a
+ * stream is under 64 bytes and many can be open at once.
+ */
+
+#ifndef CIPHER_STREAM_H
+#define CIPHER_STREAM_H
+
+#include "aes_key.h"
+
+enum CipherMode{
+    MODE_ECB,       // Each block on its own
+    MODE_CBC,       // Each block chained into the next, 16 byte iv
+    MODE_CTR        // Keystream from a 16 byte big endian counter, any length
+};
+
+/*
+ * CipherStream
+ * One message in one direction under a shared AesKey, which must
+ * outlive the stream. ECB and CBC encryption zero pad a partial
+ * last block, like encrypt() in aes.h, so their ciphertext is
+ * always whole blocks. CTR output is exactly as long as its input.
+ * 
+ * update writes the output for every whole block it can complete,
+ * which is up to 15 bytes more or less than it was given for ECB
+ * and CBC. in and out may be the same buffer in CTR mode, or in
+ * the other modes while no partial block is held; otherwise they
+ * must not overlap.
+ */
+class CipherStream{
+public:
+    CipherStream(const AesKey & key, CipherMode mode, bool encrypting,
+                 const unsigned char * iv = nullptr, AesEngine engine = ENGINE_AUTO);
+    
+    // Adds length bytes of input, returns the bytes written to out, at most length + 15
+    size_t update(const unsigned char * in, size_t length, unsigned char * out);
+    // Writes what is held back, at most 16 bytes, and returns its length, reset starts the next message
+    size_t finalize(unsigned char * out);
+    // Drops any input and starts a new message, with a new iv for CBC and CTR
+    void reset(const unsigned char * iv = nullptr);
+    
+    // Bytes of input held until more arrives
+    size_t buffered() const;
+
+private:
+    // Runs whole blocks from in to out, chaining or counting as the mode needs
+    void cryptBlocks(const unsigned char * in, unsigned char * out, size_t blocks);
+    // Runs length bytes through the counter keystream, keeping the unused part of its last block
+    void cryptCounter(const unsigned char * in, unsigned char * out, size_t length);
+    
+    const AesKey & _key;
+    AesEngine _engine;
+    CipherMode _mode;
+    bool _encrypting;
+    unsigned char _used;        // Bytes of _block held (ECB, CBC) or keystream used (CTR)
+    unsigned char _chain[16];   // Last ciphertext block for CBC, next counter for CTR
+    unsigned char _block[16];   // Partial input block, or the current keystream block
+};
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * circulant_mds.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Circulant MDS mixing layers fixed at compile time by their
+ * first row. Every coefficient is a sum of powers of x, so each
+ * input element is multiplied up a shared chain of x multiplies
+ * and every product is a few additions from the chain: M * column
+ * for the AES matrix (02, 03, 01, 01) takes 4 x multiplies instead
+ * of 16 general field multiplies.
+ * 
+ * Works on Rijndael field bytes or on GaloisPolynomial elements
+ * of whatever field is set, so other ciphers' circulant matrices
+ * use the same template.
+ */
+
+#ifndef CIRCULANT_MDS_H
+#define CIRCULANT_MDS_H
+
+#include "aes_tables.h"
+#include "galois_field.h"
+#include "matrix.h"
+#include <stdexcept>
+#include <utility>
+
+using std::runtime_error;
+
+/*
+ * FieldOps
+ * The two operations a circulant layer needs, addition and
+ * multiplication by x. The general version is for field types
+ * whose element 2 is x.
+ */
+template<typename T>
+struct FieldOps{
+    // a = a + b
+    static void add(T & a, const T & b){
+        a += b;
+    }
+    
+    // a * x
+    static T timesX(const T & a){
+        return a * T(2);
+    }
+};
+
+/*
+ * FieldOps for unsigned char
+ * Bytes of the Rijndael field, added by XOR and multiplied by x
+ * with xtime.
+ */
+template<>
+struct FieldOps<unsigned char>{
+    // a = a + b
+    static void add(unsigned char & a, unsigned char b){
+        a ^= b;
+    }
+    
+    // a * x
+    static unsigned char timesX(unsigned char a){
+        return xtime(a);
+    }
+};
+
+/*
+ * FieldOps for GaloisPolynomial
+ * Multiplying by x is a shift and at most one subtraction of the
+ * modulus, far cheaper than a general multiply.
+ */
+template<>
+struct FieldOps<GaloisPolynomial>{
+    // a = a + b
+    static void add(GaloisPolynomial & a, const GaloisPolynomial & b){
+        a += b;
+    }
+    
+    // a * x
+    static GaloisPolynomial timesX(const GaloisPolynomial & a){
+        return a.timesX();
+    }
+};
+
+// Number of x multiplies needed to reach every set bit of the coefficients
+constexpr int coefficientBits(const int * row, int size){
+    int bits = 0;
+    for(int i=0; i<size; i++){
+        while((row[i] >> bits) != 0) bits++;
+    }
+    return bits;
+}
+
+/*
+ * CirculantMds
+ * The size by size matrix whose row i is the first row rotated
+ * right by i, so entry (i, j) is Row[(j - i) mod size].
+ */
+template<int... Row>
+class CirculantMds{
+public:
+    static const int SIZE = sizeof...(Row);
+    static constexpr int ROW[SIZE] = { Row... };
+    static const int BITS = coefficientBits(ROW, SIZE);
+    
+    static_assert(SIZE > 1, "A circulant layer needs at least two elements.");
+    static_assert(BITS > 0, "A circulant layer needs a nonzero coefficient.");
+    
+    // Performs column = M * column on SIZE elements
+    template<typename T>
+    static void apply(T * column){
+        // chain[b][j] is x^b * column[j], shared by every row
+        T chain[BITS][SIZE];
+        for(int j=0; j<SIZE; j++) chain[0][j] = column[j];
+        for(int b=1; b<BITS; b++){
+            for(int j=0; j<SIZE; j++) chain[b][j] = FieldOps<T>::timesX(chain[b-1][j]);
+        }
+        
+        // Rows and their terms are expanded at compile time so only the set coefficient bits cost anything
+        T out[SIZE];
+        rows(out, chain, std::make_index_sequence<SIZE>());
+        for(int i=0; i<SIZE; i++) column[i] = out[i];
+    }
+    
+    // Performs state = M * state, column by column
+    template<typename T>
+    static QSMatrix<T> & apply(QSMatrix<T> & state){
+        if(state.getRows() != SIZE) throw runtime_error("State rows do not match the circulant layer.");
+        T column[SIZE];
+        for(int c=0; c<state.getCols(); c++){
+            for(int r=0; r<SIZE; r++) column[r] = state(r, c);
+            apply(column);
+            for(int r=0; r<SIZE; r++) state(r, c) = column[r];
+        }
+        return state;
+    }
+    
+    // The layer as a general matrix, for checking against QSMatrix products
+    template<typename T>
+    static QSMatrix<T> matrix(){
+        QSMatrix<T> m(SIZE, SIZE, T());
+        for(int i=0; i<SIZE; i++){
+            for(int j=0; j<SIZE; j++) m(i, j) = T(ROW[(j - i + SIZE) % SIZE]);
+        }
+        return m;
+    }
+    
+private:
+    // out[I] = sum over J of Row[(J - I) mod SIZE] * column[J], for every row I
+    template<typename T, size_t... I>
+    static void rows(T * out, const T (*chain)[SIZE], std::index_sequence<I...>){
+        int expand[] = { (out[I] = row<I>(chain, std::make_index_sequence<SIZE>()), 0)... };
+        (void) expand;
+    }
+    
+    // One row, the sum of its SIZE terms
+    template<size_t I, typename T, size_t... J>
+    static T row(const T (*chain)[SIZE], std::index_sequence<J...>){
+        T sum = T();
+        int expand[] = { (term<ROW[(J - I + SIZE) % SIZE]>(sum, chain, J), 0)... };
+        (void) expand;
+        return sum;
+    }
+    
+    // sum += c * column[j], adding the chain entries for the set bits of c
+    template<int c, typename T>
+    static void term(T & sum, const T (*chain)[SIZE], int j){
+        for(int b=0; b<BITS; b++){
+            if((c >> b) & 1) FieldOps<T>::add(sum, chain[b][j]);
+        }
+    }
+};
+
+template<int... Row>
+constexpr int CirculantMds<Row...>::ROW[];
+
+// AES mix columns
+typedef CirculantMds<2, 3, 1, 1> AesMixLayer;
+// Inverse mix columns is M * (05, 00, 04, 00), so this then AesMixLayer undoes AesMixLayer
+typedef CirculantMds<5, 0, 4, 0> AesMixLayerInversePre;
+
+// Performs column = M_inverse * column for the AES matrix
+template<typename T>
+void aesMixLayer_inverse(T * column){
+    AesMixLayerInversePre::apply(column);
+    AesMixLayer::apply(column);
+}
+
+#endif
@@ -0,0 +1,118 @@
+/*
+ * cmac.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * AES-CMAC (NIST SP 800-38B, RFC 4493). A CBC-MAC whose last
+ * block is masked by one of two subkeys, L*x or L*x^2 in
+ * GF(2^128) mod x^128 + x^7 + x^2 + x + 1, where L is the
+ * encryption of the zero block.
+ */
+
+#ifndef CMAC_CPP
+#define CMAC_CPP
+
+#include "cmac.h"
+#include "byte_order.h"
+#include <cstring>
+
+// Multiply by x: the block is a big endian polynomial, x^128 folds back as 0x87
+static void multiplyX(const unsigned char * in, unsigned char * out){
+    uint64_t hi = loadBig64(in);
+    uint64_t lo = loadBig64(in + 8);
+    uint64_t carry = hi >> 63;
+    hi = (hi << 1) | (lo >> 63);
+    lo = (lo << 1) ^ (0x87 * carry);
+    storeBig64(out, hi);
+    storeBig64(out + 8, lo);
+}
+
+// Checks a tag length is one CMAC allows
+static void checkTagLength(size_t tagLength){
+    if(tagLength < 1 || tagLength > 16) throw runtime_error("CMAC tag must be 1 to 16 bytes.");
+}
+
+Cmac::Cmac(const AesKey & key, AesEngine engine): _key(key), _engine(resolveEngine(engine)) {
+    unsigned char l[16] = {0};
+    encryptBlocks(_engine, _key, l, l, 1);
+    multiplyX(l, _k1);
+    multiplyX(_k1, _k2);
+}
+
+// Writes the first tagLength bytes of the tag of a whole message
+void Cmac::mac(const unsigned char * message, size_t length, unsigned char * tag, size_t tagLength) const{
+    CmacStream stream(*this);
+    stream.update(message, length);
+    stream.finalize(tag, tagLength);
+}
+
+// Returns true if tag matches the message, compared in constant time
+bool Cmac::verify(const unsigned char * message, size_t length, const unsigned char * tag, size_t tagLength) const{
+    checkTagLength(tagLength);
+    unsigned char expected[16];
+    mac(message, length, expected, 16);
+    
+    unsigned char diff = 0;
+    for(size_t i=0; i<tagLength; i++){
+        diff |= expected[i] ^ tag[i];
+    }
+    return diff == 0;
+}
+
+CmacStream::CmacStream(const Cmac & cmac): _cmac(cmac) {
+    reset();
+}
+
+// Adds length bytes of message
+void CmacStream::update(const unsigned char * data, size_t length){
+    if(length == 0) return;
+    
+    // Top up the held block, it is only chained once more input shows it is not the last
+    size_t take = 16 - _lastLength;
+    if(take > length) take = length;
+    memcpy(_last + _lastLength, data, take);
+    _lastLength += take;
+    data += take;
+    length -= take;
+    if(length == 0) return;
+    
+    cbcMacBlocks(_cmac._engine, _cmac._key, _state, _last, 1);
+    
+    // Chain every whole block straight from the input except the final one
+    size_t blocks = (length - 1) / 16;
+    cbcMacBlocks(_cmac._engine, _cmac._key, _state, data, blocks);
+    data += 16*blocks;
+    length -= 16*blocks;
+    
+    memcpy(_last, data, length);
+    _lastLength = length;
+}
+
+// Writes the first tagLength bytes of the tag and starts a new message
+void CmacStream::finalize(unsigned char * tag, size_t tagLength){
+    checkTagLength(tagLength);
+    
+    // A whole last block is masked by K1, a partial one is padded with 10...0 and masked by K2
+    unsigned char block[16];
+    if(_lastLength == 16){
+        xorBytes(block, _last, _cmac._k1, 16);
+    }
+    else{
+        memcpy(block, _last, _lastLength);
+        block[_lastLength] = 0x80;
+        memset(block + _lastLength + 1, 0, 15 - _lastLength);
+        xorBytes(block, block, _cmac._k2, 16);
+    }
+    cbcMacBlocks(_cmac._engine, _cmac._key, _state, block, 1);
+    
+    memcpy(tag, _state, tagLength);
+    reset();
+}
+
+// Drops any input and starts a new message
+void CmacStream::reset(){
+    memset(_state, 0, 16);
+    _lastLength = 0;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * cmac.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * AES-CMAC (NIST SP 800-38B, RFC 4493). A CBC-MAC whose last
+ * block is masked by one of two subkeys, L*x or L*x^2 in
+ * GF(2^128) mod x^128 + x^7 + x^2 + x + 1, where L is the
+ * encryption of the zero block.
+ */
+
+#ifndef CMAC_H
+#define CMAC_H
+
+#include "aes_key.h"
+
+/*
+ * Cmac
+ * Holds an expanded AES key and its two subkeys. Nothing is
+ * modified after construction, so one object may authenticate
+ * from many threads at once.
+ */
+class Cmac{
+public:
+    Cmac(const AesKey & key, AesEngine engine = ENGINE_AUTO);
+    
+    // Writes the first tagLength bytes of the tag of a whole message
+    void mac(const unsigned char * message, size_t length, unsigned char * tag, size_t tagLength = 16) const;
+    // Returns true if tag matches the message, compared in constant time
+    bool verify(const unsigned char * message, size_t length, const unsigned char * tag, size_t tagLength = 16) const;
+
+private:
+    friend class CmacStream;
+    
+    AesKey _key;
+    AesEngine _engine;
+    unsigned char _k1[16];  // Masks a complete last block
+    unsigned char _k2[16];  // Masks a padded last block
+};
+
+/*
+ * CmacStream
+ * Incremental CMAC over input arriving in pieces of any size.
+ * The last block is held back until finalize, since it is masked
+ * differently. The Cmac must outlive the stream.
+ */
+class CmacStream{
+public:
+    explicit CmacStream(const Cmac & cmac);
+    
+    // Adds length bytes of message
+    void update(const unsigned char * data, size_t length);
+    // Writes the first tagLength bytes of the tag and starts a new message
+    void finalize(unsigned char * tag, size_t tagLength = 16);
+    // Drops any input and starts a new message
+    void reset();
+
+private:
+    const Cmac & _cmac;
+    unsigned char _state[16];   // Chaining value after the blocks processed so far
+    unsigned char _last[16];    // Input not yet processed, at most one block
+    size_t _lastLength;
+};
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * cpu_features.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Runtime detection of the processor instructions used
+ * by the hardware accelerated engines.
+ */
+
+#ifndef CPU_FEATURES_CPP
+#define CPU_FEATURES_CPP
+
+#include "cpu_features.h"
+
+#ifdef AES_X86
+#include <cpuid.h>
+
+// Reads the feature flags in ecx of cpuid leaf 1
+static unsigned int cpuidFeatures(){
+    unsigned int eax, ebx, ecx, edx;
+    if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return 0;
+    return ecx;
+}
+
+// AES-NI is ecx bit 25, the engines also need SSSE3 (bit 9) for byte shuffles
+bool cpuHasAesni(){
+    static const bool has = (cpuidFeatures() & ((1u << 25) | (1u << 9))) == ((1u << 25) | (1u << 9));
+    return has;
+}
+
+// PCLMULQDQ is ecx bit 1, GHASH also needs SSSE3 (bit 9) for byte shuffles
+bool cpuHasClmul(){
+    static const bool has = (cpuidFeatures() & ((1u << 1) | (1u << 9))) == ((1u << 1) | (1u << 9));
+    return has;
+}
+
+#else
+
+bool cpuHasAesni(){
+    return false;
+}
+
+bool cpuHasClmul(){
+    return false;
+}
+
+#endif
+
+#endif
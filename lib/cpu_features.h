@@ -0,0 +1,23 @@
+/*
+ * cpu_features.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Runtime detection of the processor instructions used
+ * by the hardware accelerated engines.
+ */
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+// Intrinsic code paths are only compiled for x86 targets
+#if defined(__x86_64__) || defined(__i386__)
+#define AES_X86 1
+#endif
+
+// Returns true if the processor has the AES-NI instructions
+bool cpuHasAesni();
+// Returns true if the processor has carry-less multiplication (PCLMULQDQ)
+bool cpuHasClmul();
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * exponent.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Non-negative integers of any size for exponents.
+ */
+
+#ifndef EXPONENT_CPP
+#define EXPONENT_CPP
+
+#include "exponent.h"
+#include <algorithm>
+#include <stdexcept>
+
+using std::runtime_error;
+
+typedef unsigned __int128 Wide;
+
+Exponent::Exponent(uint64_t value){
+    if(value != 0) _limbs.push_back(value);
+}
+
+// Parses decimal digits
+Exponent Exponent::fromString(const string & digits){
+    if(digits.empty()) throw runtime_error("Exponent has no digits.");
+    Exponent e;
+    for(size_t i=0; i<digits.size(); i++){
+        if(digits[i] < '0' || digits[i] > '9') throw runtime_error("Exponent must be decimal digits.");
+        e *= 10;
+        e += (uint64_t) (digits[i] - '0');
+    }
+    return e;
+}
+
+// base^n
+Exponent Exponent::power(uint64_t base, int n){
+    Exponent e(1);
+    for(int i=0; i<n; i++) e *= base;
+    return e;
+}
+
+// Add a small value
+Exponent & Exponent::operator+=(uint64_t value){
+    for(size_t i=0; i<_limbs.size() && value != 0; i++){
+        _limbs[i] += value;
+        value = _limbs[i] < value ? 1 : 0;
+    }
+    if(value != 0) _limbs.push_back(value);
+    return *this;
+}
+
+// Subtract a small value, which must not exceed this one
+Exponent & Exponent::operator-=(uint64_t value){
+    if(_limbs.empty() ? value != 0 : (_limbs.size() == 1 && _limbs[0] < value)) throw runtime_error("Exponent would be negative.");
+    for(size_t i=0; i<_limbs.size() && value != 0; i++){
+        uint64_t before = _limbs[i];
+        _limbs[i] -= value;
+        value = before < value ? 1 : 0;
+    }
+    trim();
+    return *this;
+}
+
+// Multiply by a small value
+Exponent & Exponent::operator*=(uint64_t value){
+    uint64_t carry = 0;
+    for(size_t i=0; i<_limbs.size(); i++){
+        Wide product = (Wide) _limbs[i] * value + carry;
+        _limbs[i] = (uint64_t) product;
+        carry = (uint64_t) (product >> 64);
+    }
+    if(carry != 0) _limbs.push_back(carry);
+    trim();
+    return *this;
+}
+
+// Divide by a nonzero small value, returning the remainder
+uint64_t Exponent::divide(uint64_t divisor){
+    if(divisor == 0) throw runtime_error("Exponent division by zero.");
+    Wide remainder = 0;
+    for(size_t i=_limbs.size(); i-- > 0; ){
+        Wide current = (remainder << 64) | _limbs[i];
+        _limbs[i] = (uint64_t) (current / divisor);
+        remainder = current % divisor;
+    }
+    trim();
+    return (uint64_t) remainder;
+}
+
+bool Exponent::operator==(const Exponent & other) const{
+    return _limbs == other._limbs;
+}
+
+bool Exponent::operator!=(const Exponent & other) const{
+    return _limbs != other._limbs;
+}
+
+// Number of bits up to the highest set bit, 0 for zero
+int Exponent::bitLength() const{
+    if(_limbs.empty()) return 0;
+    return 64 * ((int) _limbs.size() - 1) + 64 - __builtin_clzll(_limbs.back());
+}
+
+// Bit i, counting from the lowest
+bool Exponent::bit(int i) const{
+    size_t limb = i / 64;
+    return limb < _limbs.size() && ((_limbs[limb] >> (i % 64)) & 1);
+}
+
+bool Exponent::isZero() const{
+    return _limbs.empty();
+}
+
+// Decimal digits
+string Exponent::toString() const{
+    if(_limbs.empty()) return "0";
+    Exponent e(*this);
+    string s;
+    while(!e.isZero()) s.push_back((char) ('0' + e.divide(10)));
+    std::reverse(s.begin(), s.end());
+    return s;
+}
+
+// Drops leading zero limbs
+void Exponent::trim(){
+    while(!_limbs.empty() && _limbs.back() == 0) _limbs.pop_back();
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * exponent.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Non-negative integers of any size for exponents such as
+ * p^n - 2 in GF(2^128), which do not fit a machine word. Only
+ * the operations powering and order checks need are provided.
+ */
+
+#ifndef EXPONENT_H
+#define EXPONENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::uint64_t;
+using std::vector;
+
+/*
+ * Exponent
+ * An unsigned integer as 64 bit limbs, lowest first, with no
+ * leading zero limbs.
+ */
+class Exponent{
+public:
+    Exponent(uint64_t value = 0);
+    // Parses decimal digits
+    static Exponent fromString(const string & digits);
+    // base^n
+    static Exponent power(uint64_t base, int n);
+    
+    // Add a small value
+    Exponent & operator+=(uint64_t value);
+    // Subtract a small value, which must not exceed this one
+    Exponent & operator-=(uint64_t value);
+    // Multiply by a small value
+    Exponent & operator*=(uint64_t value);
+    // Divide by a nonzero small value, returning the remainder
+    uint64_t divide(uint64_t divisor);
+    
+    bool operator==(const Exponent & other) const;
+    bool operator!=(const Exponent & other) const;
+    
+    // Number of bits up to the highest set bit, 0 for zero
+    int bitLength() const;
+    // Bit i, counting from the lowest
+    bool bit(int i) const;
+    bool isZero() const;
+    
+    // Decimal digits
+    string toString() const;
+
+private:
+    // Drops leading zero limbs
+    void trim();
+    
+    vector<uint64_t> _limbs;
+};
+
+#endif
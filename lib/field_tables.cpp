@@ -0,0 +1,290 @@
+/*
+ * field_tables.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Exp, log and inverse tables for a whole field GF(p^n), built
+ * by powering a generator in parallel chunks.
+ */
+
+#ifndef FIELD_TABLES_CPP
+#define FIELD_TABLES_CPP
+
+#include "field_tables.h"
+#include "parallel.h"
+#include <cstring>
+
+/*
+ * FieldArithmetic
+ * Multiplication of elements numbered as base p digits, mod a
+ * monic modulus. Characteristic 2 works on the bits directly,
+ * other primes go through digit arrays, with 64 bit products since
+ * p may be as large as 2^24.
+ */
+class FieldArithmetic{
+public:
+    FieldArithmetic(const FieldTablesHeader & header):
+        _p(header.prime), _n(header.degree), _bits(0), _m(header.modulus, header.modulus + header.degree + 1) {
+        for(int i=0; i<=_n && _p == 2; i++){
+            _bits |= (uint32_t) _m[i] << i;
+        }
+    }
+    
+    // Product of two elements
+    uint32_t multiply(uint32_t a, uint32_t b) const{
+        if(_p == 2){
+            uint32_t r = 0;
+            while(b != 0){
+                if(b & 1) r ^= a;
+                b >>= 1;
+                a <<= 1;
+                if((a >> _n) & 1) a ^= _bits;
+            }
+            return r;
+        }
+        
+        int64_t x[32], y[32], product[64] = {0};
+        digits(a, x);
+        digits(b, y);
+        for(int i=0; i<_n; i++){
+            for(int j=0; j<_n; j++){
+                product[i+j] = (product[i+j] + x[i]*y[j]) % _p;
+            }
+        }
+        // Long division by the monic modulus from the top term down
+        for(int k=2*_n-2; k>=_n; k--){
+            int64_t c = product[k];
+            if(c == 0) continue;
+            for(int j=0; j<=_n; j++){
+                product[k-_n+j] = ((product[k-_n+j] - c*_m[j]) % _p + _p) % _p;
+            }
+        }
+        uint32_t r = 0;
+        for(int i=_n-1; i>=0; i--){
+            r = r*_p + product[i];
+        }
+        return r;
+    }
+    
+    // a^e by square and multiply
+    uint32_t power(uint32_t a, uint64_t e) const{
+        uint32_t r = 1;
+        while(e != 0){
+            if(e & 1) r = multiply(r, a);
+            a = multiply(a, a);
+            e >>= 1;
+        }
+        return r;
+    }
+
+private:
+    // Splits an element into its n base p digits, lowest first
+    void digits(uint32_t a, int64_t * d) const{
+        for(int i=0; i<_n; i++){
+            d[i] = a % _p;
+            a /= _p;
+        }
+    }
+    
+    int64_t _p;
+    int _n;
+    uint32_t _bits;     // Modulus as a bit mask when p is 2
+    vector<int64_t> _m;
+};
+
+// a^e mod p by square and multiply
+static int64_t powerMod(int64_t a, uint64_t e, int64_t p){
+    int64_t r = 1;
+    a %= p;
+    while(e != 0){
+        if(e & 1) r = r * a % p;
+        a = a * a % p;
+        e >>= 1;
+    }
+    return r;
+}
+
+// Distinct prime factors of n by trial division
+static vector<uint32_t> primeFactors(uint32_t n){
+    vector<uint32_t> factors;
+    for(uint32_t d=2; (uint64_t) d*d<=n; d++){
+        if(n % d != 0) continue;
+        factors.push_back(d);
+        while(n % d == 0) n /= d;
+    }
+    if(n > 1) factors.push_back(n);
+    return factors;
+}
+
+// Whether g has order exactly q - 1, which also shows the modulus is irreducible
+static bool isGenerator(const FieldArithmetic & f, uint32_t g, uint32_t q, const vector<uint32_t> & factors){
+    // In a field every nonzero element has g^(q-1) = 1, so failing that proves the modulus reducible
+    if(f.power(g, q - 1) != 1) throw runtime_error("Modulus is not irreducible, the field has no generator.");
+    for(size_t i=0; i<factors.size(); i++){
+        if(f.power(g, (q - 1) / factors[i]) == 1) return false;
+    }
+    return true;
+}
+
+// Writes entry i of a table of the given width
+static void putEntry(unsigned char * table, uint32_t width, uint32_t i, uint32_t v){
+    if(width == 1) table[i] = (unsigned char) v;
+    else if(width == 2){
+        uint16_t w = (uint16_t) v;
+        memcpy(table + 2*(size_t) i, &w, 2);
+    }
+    else memcpy(table + 4*(size_t) i, &v, 4);
+}
+
+FieldTables::FieldTables(const Polynomial & modulus, int threads){
+    FieldTablesHeader h = {};
+    int p = modulus.getPrime();
+    int n = modulus.size() - 1;
+    if(p < 2 || n < 1 || n > 24) throw runtime_error("Field tables need a modulus of degree 1 to 24.");
+    
+    uint64_t q = 1;
+    for(int i=0; i<n && q<=FIELD_TABLES_MAX_ORDER; i++) q *= p;
+    if(q > FIELD_TABLES_MAX_ORDER) throw runtime_error("Field is too large for tables.");
+    
+    // Make the modulus monic so division never needs an inverse, lead^(p-2) being the lead's inverse
+    int64_t lead = (modulus[n].value() % p + p) % p;
+    if(lead == 0) throw runtime_error("Field tables need a modulus with a nonzero lead coefficient.");
+    int64_t leadInverse = powerMod(lead, p - 2, p);
+    for(int i=0; i<=n; i++){
+        h.modulus[i] = (uint32_t) ((modulus[i].value() % p + p) % p * leadInverse % p);
+    }
+    h.prime = p;
+    h.degree = n;
+    h.order = (uint32_t) q;
+    h.width = q <= 256 ? 1 : q <= 65536 ? 2 : 4;
+    
+    // Try x first, which is a generator whenever the modulus is primitive
+    FieldArithmetic f(h);
+    vector<uint32_t> factors = primeFactors(h.order - 1);
+    uint32_t g = 0;
+    if(h.order == 2) g = 1;
+    else if(n > 1 && isGenerator(f, p, h.order, factors)) g = p;
+    else{
+        for(uint32_t c=2; c<h.order && g==0; c++){
+            if(isGenerator(f, c, h.order, factors)) g = c;
+        }
+    }
+    if(g == 0) throw runtime_error("Modulus is not irreducible, the field has no generator.");
+    h.generator = g;
+    
+    size_t tableBytes = (size_t) h.order * h.width;
+    _storage.assign(sizeof(h) + 3*tableBytes, 0);
+    memcpy(_storage.data(), &h, sizeof(h));
+    unsigned char * expTable = _storage.data() + sizeof(h);
+    unsigned char * logTable = expTable + tableBytes;
+    unsigned char * inverseTable = logTable + tableBytes;
+    
+    // Each chunk starts at g^begin and steps by g, writing exp and scattering log
+    uint32_t steps = h.order - 1;
+    parallelFor(steps, threads, [&](size_t begin, size_t end){
+        uint32_t v = f.power(g, begin);
+        for(size_t i=begin; i<end; i++){
+            putEntry(expTable, h.width, i, v);
+            putEntry(logTable, h.width, v, i);
+            v = f.multiply(v, g);
+        }
+    });
+    putEntry(expTable, h.width, steps, 1);
+    
+    // The inverse of g^i is g^(q-1-i)
+    attach(_storage.data(), _storage.size());
+    parallelFor(steps, threads, [&](size_t begin, size_t end){
+        for(size_t i=begin; i<end; i++){
+            putEntry(inverseTable, h.width, exp(i), exp(i == 0 ? 0 : steps - i));
+        }
+    });
+}
+
+FieldTables::FieldTables(ConstByteSpan stored){
+    attach(stored.data, stored.size);
+}
+
+// Checks the header and points the tables into data
+void FieldTables::attach(const unsigned char * data, size_t size){
+    if(size < sizeof(FieldTablesHeader)) throw runtime_error("Field tables are truncated.");
+    memcpy(&_header, data, sizeof(_header));
+    uint32_t w = _header.width;
+    if((w != 1 && w != 2 && w != 4) || _header.order < 2 || _header.order > FIELD_TABLES_MAX_ORDER ||
+       size != sizeof(FieldTablesHeader) + 3*(size_t) _header.order*w){
+        throw runtime_error("Field tables are damaged.");
+    }
+    _data = data;
+    _size = size;
+    _exp = data + sizeof(FieldTablesHeader);
+    _log = _exp + (size_t) _header.order*w;
+    _inverse = _log + (size_t) _header.order*w;
+}
+
+// Entry i of a table
+uint32_t FieldTables::entry(const unsigned char * table, uint32_t i) const{
+    if(_header.width == 1) return table[i];
+    if(_header.width == 2){
+        uint16_t v;
+        memcpy(&v, table + 2*(size_t) i, 2);
+        return v;
+    }
+    uint32_t v;
+    memcpy(&v, table + 4*(size_t) i, 4);
+    return v;
+}
+
+// Characteristic p
+int FieldTables::prime() const{
+    return _header.prime;
+}
+
+// Degree n of the modulus
+int FieldTables::degree() const{
+    return _header.degree;
+}
+
+// Number of elements, p^n
+uint32_t FieldTables::order() const{
+    return _header.order;
+}
+
+// The generator the tables were built from
+uint32_t FieldTables::generator() const{
+    return _header.generator;
+}
+
+// g^i for i below order - 1
+uint32_t FieldTables::exp(uint32_t i) const{
+    return entry(_exp, i);
+}
+
+// i with g^i = a, for nonzero a
+uint32_t FieldTables::log(uint32_t a) const{
+    if(a == 0 || a >= _header.order) throw runtime_error("Log of zero or a value outside the field.");
+    return entry(_log, a);
+}
+
+// Multiplicative inverse, 0 for 0
+uint32_t FieldTables::inverse(uint32_t a) const{
+    return entry(_inverse, a);
+}
+
+// Product of two elements through the log tables
+uint32_t FieldTables::multiply(uint32_t a, uint32_t b) const{
+    if(a == 0 || b == 0) return 0;
+    uint32_t i = entry(_log, a) + entry(_log, b);
+    if(i >= _header.order - 1) i -= _header.order - 1;
+    return entry(_exp, i);
+}
+
+// The header and tables as they are stored
+ConstByteSpan FieldTables::bytes() const{
+    return ConstByteSpan(_data, _size);
+}
+
+// Adds field tables to a table file, found again as a SECTION_FIELD_TABLES section
+void addFieldTables(TableFileWriter & writer, const FieldTables & tables){
+    writer.addSection(SECTION_FIELD_TABLES, 1, tables.order(), tables.bytes());
+}
+
+#endif
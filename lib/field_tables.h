@@ -0,0 +1,102 @@
+/*
+ * field_tables.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Exp, log and inverse tables for a whole field GF(p^n), for
+ * any modulus a Polynomial describes. Elements are numbered by
+ * Polynomial::toInt(), the coefficients as base p digits.
+ * 
+ * Tables are built by powering a generator g: exp[i] = g^i, so
+ * log and inverse follow from one pass with no per element
+ * Euclid. The powers are split into chunks across threads, each
+ * chunk starting from g^begin by square and multiply.
+ */
+
+#ifndef FIELD_TABLES_H
+#define FIELD_TABLES_H
+
+#include "galois_field.h"
+#include "byte_span.h"
+#include "table_file.h"
+#include <cstdint>
+#include <vector>
+
+using std::uint32_t;
+using std::vector;
+
+// Largest field the tables are built for, three tables of this many entries
+const uint32_t FIELD_TABLES_MAX_ORDER = 1u << 24;
+
+/*
+ * FieldTablesHeader
+ * Start of the stored tables. The exp, log and inverse tables
+ * follow, order entries each of width bytes.
+ */
+struct FieldTablesHeader{
+    uint32_t prime;
+    uint32_t degree;
+    uint32_t order;         // prime^degree
+    uint32_t generator;     // Element whose powers give every nonzero element
+    uint32_t width;         // Bytes per entry, 1, 2 or 4
+    uint32_t reserved[2];
+    uint32_t modulus[25];   // Monic modulus coefficients, lowest first, degree + 1 of them
+};
+
+/*
+ * FieldTables
+ * The tables either own their storage, when built, or view a
+ * section of a mapped table file, which must stay open. Entries
+ * are as narrow as the field allows, one byte for GF(2^8) and
+ * two for GF(2^16).
+ */
+class FieldTables{
+public:
+    // Builds the tables for the field modulus describes, using threads threads (0 for every core)
+    explicit FieldTables(const Polynomial & modulus, int threads = 0);
+    // Uses tables stored by addFieldTables in place
+    explicit FieldTables(ConstByteSpan stored);
+    FieldTables(FieldTables && other) = default;
+    FieldTables(const FieldTables &) = delete;
+    FieldTables & operator=(const FieldTables &) = delete;
+    
+    // Characteristic p
+    int prime() const;
+    // Degree n of the modulus
+    int degree() const;
+    // Number of elements, p^n
+    uint32_t order() const;
+    // The generator the tables were built from
+    uint32_t generator() const;
+    
+    // g^i for i below order - 1
+    uint32_t exp(uint32_t i) const;
+    // i with g^i = a, for nonzero a
+    uint32_t log(uint32_t a) const;
+    // Multiplicative inverse, 0 for 0
+    uint32_t inverse(uint32_t a) const;
+    // Product of two elements through the log tables
+    uint32_t multiply(uint32_t a, uint32_t b) const;
+    
+    // The header and tables as they are stored
+    ConstByteSpan bytes() const;
+
+private:
+    // Entry i of a table
+    uint32_t entry(const unsigned char * table, uint32_t i) const;
+    // Checks the header and points the tables into data
+    void attach(const unsigned char * data, size_t size);
+    
+    vector<unsigned char> _storage;
+    const unsigned char * _data;
+    size_t _size;
+    FieldTablesHeader _header;
+    const unsigned char * _exp;
+    const unsigned char * _log;
+    const unsigned char * _inverse;
+};
+
+// Adds field tables to a table file, found again as a SECTION_FIELD_TABLES section
+void addFieldTables(TableFileWriter & writer, const FieldTables & tables);
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * frobenius.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Matrices of the Frobenius map a -> a^(p^k) mod a modulus.
+ */
+
+#ifndef FROBENIUS_CPP
+#define FROBENIUS_CPP
+
+#include "frobenius.h"
+
+// Coefficients of a, lowest first and reduced mod p, padded to n
+static vector<int> coefficients(const Polynomial & a, int n){
+    int p = a.getPrime();
+    vector<int> c(n, 0);
+    for(int i=0; i<a.size() && i<n; i++) c[i] = (a[i].value() % p + p) % p;
+    return c;
+}
+
+// Polynomial with the given coefficients, lowest first
+static Polynomial fromCoefficients(const vector<int> & c, int p){
+    vector<Modular<int>> a(c.begin(), c.end());
+    return Polynomial(a, p);
+}
+
+// The map a -> a^(p^k) mod modulus, for k at least 0
+FrobeniusMap::FrobeniusMap(const Polynomial & modulus, int k): _p(modulus.getPrime()), _n(modulus.size() - 1), _k(k) {
+    if(_n < 1) throw runtime_error("Modulus must have degree at least 1.");
+    if(k < 0) throw runtime_error("Frobenius power must not be negative.");
+    
+    // Column j is h^j for h = x^(p^k), since (x^j)^(p^k) = (x^(p^k))^j
+    Polynomial h = Polynomial(vector<Modular<int>>{ 0, 1 }, _p).powMod(Exponent::power(_p, k), modulus);
+    Polynomial column = Polynomial(1, _p, 1) % modulus;
+    for(int j=0; j<_n; j++){
+        _columns.push_back(coefficients(column, _n));
+        column = (column * h) % modulus;
+    }
+}
+
+FrobeniusMap::FrobeniusMap(int p, int n, int k): _p(p), _n(n), _k(k) {}
+
+// a^(p^k) on coefficients: the coefficients are in GF(p), fixed by the map, so the image is sum a_j column_j
+vector<int> FrobeniusMap::applyCoefficients(const vector<int> & a) const{
+    vector<long long> sum(_n, 0);
+    for(int j=0; j<_n; j++){
+        if(a[j] == 0) continue;
+        const vector<int> & column = _columns[j];
+        for(int i=0; i<_n; i++) sum[i] = (sum[i] + (long long) a[j] * column[i]) % _p;
+    }
+    return vector<int>(sum.begin(), sum.end());
+}
+
+// a^(p^k) mod modulus, as one matrix product
+Polynomial FrobeniusMap::apply(const Polynomial & a) const{
+    if(a.getPrime() != _p) throw runtime_error("Mismatched prime.");
+    if(a.size() > _n) throw runtime_error("Polynomial must be reduced mod the modulus.");
+    return fromCoefficients(applyCoefficients(coefficients(a, _n)), _p);
+}
+
+// a^(p^k) for an element of the field set by GaloisPolynomial::globalSetModulus
+GaloisPolynomial FrobeniusMap::apply(const GaloisPolynomial & a) const{
+    if(a.size() > _n) throw runtime_error("Element is not from this field.");
+    vector<int> c(_n, 0);
+    for(int i=0; i<a.size(); i++) c[i] = (a[i].value() % _p + _p) % _p;
+    return GaloisPolynomial(fromCoefficients(applyCoefficients(c), _p));
+}
+
+// The map a -> this(other(a)), which raises to p^(k + other's k)
+FrobeniusMap FrobeniusMap::operator*(const FrobeniusMap & other) const{
+    if(_p != other._p || _n != other._n) throw runtime_error("Frobenius maps are for different rings.");
+    FrobeniusMap product(_p, _n, _k + other._k);
+    for(int j=0; j<_n; j++){
+        product._columns.push_back(applyCoefficients(other._columns[j]));
+    }
+    return product;
+}
+
+int FrobeniusMap::prime() const{
+    return _p;
+}
+
+// Degree n of the modulus
+int FrobeniusMap::degree() const{
+    return _n;
+}
+
+// k, the map raises to p^k
+int FrobeniusMap::power() const{
+    return _k;
+}
+
+#endif
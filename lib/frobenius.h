@@ -0,0 +1,55 @@
+/*
+ * frobenius.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * The Frobenius map a -> a^p is linear over GF(p) on the ring
+ * GF(p)[x] / (f), so a -> a^(p^k) is an n by n matrix over GF(p)
+ * whose column j is x^(j p^k) mod f. Once the matrix is built
+ * every further a^(p^k), such as the x^(p^i) chain of an
+ * irreducibility test or a conjugate in GF(p^n), is one matrix
+ * product instead of k log p squarings.
+ */
+
+#ifndef FROBENIUS_H
+#define FROBENIUS_H
+
+#include "galois_field.h"
+#include <vector>
+
+using std::vector;
+
+/*
+ * FrobeniusMap
+ * The matrix of a -> a^(p^k) mod a fixed modulus of degree n.
+ */
+class FrobeniusMap{
+public:
+    // The map a -> a^(p^k) mod modulus, for k at least 0
+    explicit FrobeniusMap(const Polynomial & modulus, int k = 1);
+    
+    // a^(p^k) mod modulus, as one matrix product
+    Polynomial apply(const Polynomial & a) const;
+    // a^(p^k) for an element of the field set by GaloisPolynomial::globalSetModulus, which must be this modulus
+    GaloisPolynomial apply(const GaloisPolynomial & a) const;
+    // The map a -> this(other(a)), which raises to p^(k + other's k)
+    FrobeniusMap operator*(const FrobeniusMap & other) const;
+    
+    int prime() const;
+    // Degree n of the modulus
+    int degree() const;
+    // k, the map raises to p^k
+    int power() const;
+
+private:
+    FrobeniusMap(int p, int n, int k);
+    // a^(p^k) on coefficients, lowest first
+    vector<int> applyCoefficients(const vector<int> & a) const;
+    
+    int _p;
+    int _n;
+    int _k;
+    vector<vector<int>> _columns;   // Column j is x^(j p^k) mod modulus, n coefficients lowest first
+};
+
+#endif
@@ -22,6 +22,7 @@
  
  
 Polynomial::Polynomial(int value, int p, int n): _p(p) {
+    INSTRUMENT_COUNT(polynomialsBuilt);
     for(int i=0; i<n; i++){
         _a.push_back(0);
     }
@@ -40,6 +41,8 @@ Polynomial::Polynomial(int value, int p, int n): _p(p) {
 }
 
 Polynomial::Polynomial(const vector<Modular<int>> & a, int p): _p(p) {
+    INSTRUMENT_COUNT(polynomialsBuilt);
+    _a.reserve(a.size());
     for(int i=0; i<a.size(); i++){
         _a.push_back(a[i]);
     }
@@ -48,8 +51,10 @@ Polynomial::Polynomial(const vector<Modular<int>> & a, int p): _p(p) {
 
 
 Polynomial::Polynomial(const Polynomial & other){
+    INSTRUMENT_COUNT(polynomialsBuilt);
     _p = other._p;
     
+    _a.reserve(other.size());
     for(int i=0; i<other.size(); i++){
         _a.push_back(other[i]);
     }
@@ -95,9 +100,15 @@ Polynomial & Polynomial::operator-=(const Polynomial & other){
 
 // Multiply two polynomials (results in higher degree n)
 Polynomial & Polynomial::operator*=(const Polynomial & other){
+    INSTRUMENT_COUNT(polynomialMultiplies);
     if(_p != other._p) throw runtime_error("Mismatched prime.");
     
-    vector<Modular<int>> a;
+    if(_p == 2){
+        multiplyBinary(other);
+        return *this;
+    }
+    
+    Coefficients a;
     
     for(int i=0; i<other.size()+this->size(); i++){
         a.push_back(0);
@@ -121,38 +132,136 @@ Polynomial & Polynomial::operator*=(const Polynomial & other){
 
 // Take the modulus of two polynomials (results in lower degree n)
 Polynomial & Polynomial::operator%=(const Polynomial & other){
+    INSTRUMENT_COUNT(polynomialReductions);
     if(_p != other._p) throw runtime_error("Mismatched prime.");
+    if(other.size() == 0) throw runtime_error("Polynomial modulus is zero.");
+    if(this->size() < other.size()) return *this;
     
-    Modular<int>::globalSetModulus(_p);
-    while(this->size() >= other.size()){
-        Modular<int> c =  _a.back().mulInverse() * other._a.back();
-        int diff = this->size()-other.size();
-        vector<Modular<int>> v;
-        for(int i=0; i< diff; i++)
-            v.push_back(0);
-        v.push_back(c);
-        Polynomial p(v,_p);
-        (*this) -= (other * p);
-    }
+    if(_p == 2) reduceBinary(other);
+    else reduceGeneral(other);
     
     return *this;
 }
 
+// Most nonzero terms a binary modulus can have to be reduced by folding, enough for pentanomials
+static const int SPARSE_MODULUS_TERMS = 5;
+
+// Coefficients over GF(2) packed 64 to a word, lowest first
+static vector<uint64_t> packBits(const Coefficients & a){
+    vector<uint64_t> w((a.size() + 63) / 64, 0);
+    for(size_t i=0; i<a.size(); i++){
+        if(a[i].value() & 1) w[i / 64] |= (uint64_t) 1 << (i % 64);
+    }
+    return w;
+}
+
+// Sets a to the low count bits of w as coefficients
+static void unpackBits(const vector<uint64_t> & w, size_t count, Coefficients & a){
+    a.assign(count, 0);
+    for(size_t i=0; i<count; i++){
+        if((w[i / 64] >> (i % 64)) & 1) a[i] = 1;
+    }
+}
+
+// w ^= t * x^position, for a position above -64 where any bits shifted below 0 are zero
+static void xorWordAt(vector<uint64_t> & w, uint64_t t, long position){
+    if(position < 0){
+        t >>= -position;
+        position = 0;
+    }
+    size_t q = position / 64;
+    int s = position % 64;
+    w[q] ^= t << s;
+    if(s != 0 && q + 1 < w.size()) w[q + 1] ^= t >> (64 - s);
+}
+
+// Drops zero words from the top of w, returns its degree or -1 if it is zero
+static long trimBits(vector<uint64_t> & w){
+    while(!w.empty() && w.back() == 0) w.pop_back();
+    return w.empty() ? -1 : 64*(long) (w.size() - 1) + 63 - __builtin_clzll(w.back());
+}
+
+// Carry-less product over GF(2): the other polynomial's words are added in at each set bit of this one
+void Polynomial::multiplyBinary(const Polynomial & other){
+    if(_a.empty() || other._a.empty()){
+        _a.clear();
+        return;
+    }
+    vector<uint64_t> x = packBits(_a), y = packBits(other._a);
+    vector<uint64_t> product(x.size() + y.size(), 0);
+    for(size_t i=0; i<x.size(); i++){
+        for(uint64_t bits=x[i]; bits!=0; bits&=bits-1){
+            long shift = 64*(long) i + __builtin_ctzll(bits);
+            for(size_t k=0; k<y.size(); k++) xorWordAt(product, y[k], shift + 64*(long) k);
+        }
+    }
+    unpackBits(product, _a.size() + other._a.size() - 1, _a);
+    reduce();
+}
+
+// Remainder over GF(2) on packed words. A sparse modulus x^n + r(x) folds each word above x^n down
+// as a few shifted copies, since x^n = r(x); any other modulus is subtracted one set bit at a time
+void Polynomial::reduceBinary(const Polynomial & modulus){
+    long n = modulus.size() - 1;
+    vector<long> terms;
+    for(long k=0; k<n; k++){
+        if(modulus._a[k].value() & 1) terms.push_back(k);
+    }
+    vector<uint64_t> w = packBits(_a);
+    
+    if((int) terms.size() + 1 <= SPARSE_MODULUS_TERMS){
+        // Folds land below the word they came from, or in its bits under x^n if r(x) reaches near x^n
+        for(long j=(long) w.size()-1; j>=0 && 64*j + 63 >= n; j--){
+            while(true){
+                long base = 64*j;
+                uint64_t t = base < n ? w[j] & (~(uint64_t) 0 << (n - base)) : w[j];
+                if(t == 0) break;
+                w[j] ^= t;
+                for(size_t k=0; k<terms.size(); k++) xorWordAt(w, t, base - n + terms[k]);
+            }
+        }
+    }
+    else{
+        vector<uint64_t> m = packBits(modulus._a);
+        for(long i=(long) _a.size()-1; i>=n; i--){
+            if(((w[i / 64] >> (i % 64)) & 1) == 0) continue;
+            for(size_t k=0; k<m.size(); k++) xorWordAt(w, m[k], i - n + 64*(long) k);
+        }
+    }
+    unpackBits(w, n, _a);
+    reduce();
+}
+
+// Remainder by long division in place, subtracting c x^k times the modulus from the top term down
+void Polynomial::reduceGeneral(const Polynomial & modulus){
+    Modular<int>::globalSetModulus(_p);
+    int m = modulus.size();
+    Modular<int> leadInverse = modulus._a.back().mulInverse();
+    for(int k=this->size()-1; k>=m-1; k--){
+        Modular<int> c = _a[k] * leadInverse;
+        if(c.value() == 0) continue;
+        for(int j=0; j<m; j++){
+            _a[k-m+1+j] -= c * modulus._a[j];
+        }
+    }
+    reduce();
+}
+
 // Take the quotient of two polynomials (results in lower degree n)
 Polynomial & Polynomial::operator/=(const Polynomial & other){
+    INSTRUMENT_COUNT(polynomialDivisions);
     if(_p != other._p) throw runtime_error("Mismatched prime.");
     
     Polynomial quot(0,_p,1);
     
     Modular<int>::globalSetModulus(_p);
     while(this->size() >= other.size()){
-        Modular<int> c =  other._a.back() / _a.back();
+        Modular<int> c = _a.back() / other._a.back();
         int diff = this->size()-other.size();
-        vector<Modular<int>> v;
-        for(int i=0; i< diff; i++)
-            v.push_back(0);
-        v.push_back(c);
-        Polynomial p(v,_p);
+        // The single term c*x^diff, built in place so it comes from the arena
+        Polynomial p(0,_p,0);
+        p._a.resize(diff, 0);
+        p._a.push_back(c);
         quot += p;
         (*this) -= (other * p);
     }
@@ -187,6 +296,116 @@ Polynomial Polynomial::operator/(const Polynomial & other) const{
     return Polynomial(*this) /= other;
 }
 
+// Multiply by x, shifting every coefficient up one place
+Polynomial & Polynomial::multiplyByX(){
+    if(!_a.empty()) _a.insert(_a.begin(), Modular<int>(0));
+    return *this;
+}
+
+// The square, which over characteristic 2 just spreads the coefficients to even places
+Polynomial Polynomial::square() const{
+    if(_p != 2) return (*this) * (*this);
+    
+    // (sum a_i x^i)^2 = sum a_i x^2i since the cross terms 2 a_i a_j vanish
+    INSTRUMENT_COUNT(polynomialMultiplies);
+    Polynomial result(0, _p, 0);
+    if(_a.empty()) return result;
+    result._a.resize(2*_a.size() - 1, 0);
+    for(int i=0; i<(int) _a.size(); i++){
+        result._a[2*i] = _a[i];
+    }
+    return result;
+}
+
+// Window width for an exponent of the given length, wider windows pay off on longer exponents
+static int windowBits(int length){
+    return length <= 8 ? 1 : length <= 24 ? 2 : length <= 80 ? 3 : length <= 240 ? 4 : 5;
+}
+
+// this^e mod modulus by sliding window exponentiation: odd powers up to 2^w - 1 are precomputed,
+// then each window of bits costs its squares and one multiply
+Polynomial Polynomial::powMod(const Exponent & e, const Polynomial & modulus) const{
+    if(_p != modulus._p) throw runtime_error("Mismatched prime.");
+    if(modulus.size() < 2) throw runtime_error("Modulus must have degree at least 1.");
+    Polynomial base = (*this) % modulus;
+    int length = e.bitLength();
+    if(length == 0) return Polynomial(1, _p, 1) % modulus;
+    
+    int w = windowBits(length);
+    vector<Polynomial> odd(1, base);
+    if(w > 1){
+        Polynomial baseSquared = base.square() % modulus;
+        for(int i=1; i<(1 << (w - 1)); i++){
+            odd.push_back((odd.back() * baseSquared) % modulus);
+        }
+    }
+    
+    // Squares of the leading 1 are skipped until the first window is multiplied in
+    Polynomial result(1, _p, 1);
+    bool started = false;
+    for(int i=length-1; i>=0; ){
+        if(!e.bit(i)){
+            if(started) result = result.square() % modulus;
+            i--;
+            continue;
+        }
+        
+        // The longest window from bit i down of at most w bits that ends in a 1
+        int j = max(i - w + 1, 0);
+        while(!e.bit(j)) j++;
+        int value = 0;
+        for(int k=i; k>=j; k--) value = 2*value + (e.bit(k) ? 1 : 0);
+        
+        if(started){
+            for(int k=i; k>=j; k--) result = result.square() % modulus;
+            result = (result * odd[value / 2]) % modulus;
+        }
+        else{
+            result = odd[value / 2];
+            started = true;
+        }
+        i = j - 1;
+    }
+    return result;
+}
+
+// Monic greatest common divisor by Euclid's algorithm, zero only if both are
+Polynomial Polynomial::gcd(const Polynomial & other) const{
+    if(_p != other._p) throw runtime_error("Mismatched prime.");
+    
+    // Over GF(2) Euclid runs on packed words, subtracting b at each set bit of a from the top
+    if(_p == 2){
+        vector<uint64_t> a = packBits(_a), b = packBits(other._a);
+        long da = trimBits(a), db = trimBits(b);
+        while(db >= 0){
+            for(long i=da; i>=db; i--){
+                if(((a[i / 64] >> (i % 64)) & 1) == 0) continue;
+                for(size_t k=0; k<b.size(); k++) xorWordAt(a, b[k], i - db + 64*(long) k);
+            }
+            a.swap(b);
+            da = db;
+            db = trimBits(b);
+        }
+        Polynomial g(0, _p, 0);
+        unpackBits(a, da + 1, g._a);
+        return g;
+    }
+    
+    Polynomial a(*this), b(other);
+    while(b.size() != 0){
+        a %= b;
+        swap(a._a, b._a);
+    }
+    
+    // Scaled by the inverse of its lead to be monic
+    if(a.size() != 0){
+        Modular<int>::globalSetModulus(_p);
+        Modular<int> leadInverse = a._a.back().mulInverse();
+        for(int i=0; i<a.size(); i++) a._a[i] *= leadInverse;
+    }
+    return a;
+}
+
 // Grab a coefficient from the polynomial
 const Modular<int> & Polynomial::operator[](int i) const{
     return _a[i];
@@ -229,7 +448,7 @@ string Polynomial::toPoly() const{
             s += to_string(i);
         }
     }
-
+    
     return s;
 }
 
@@ -263,9 +482,15 @@ void Polynomial::reduce(){
  * calculating the multiplicative inverse mod the modulus polynomial.
  */
  
-Polynomial GaloisPolynomial::_modulus(vector<Modular<int>>{
-    1, 0, 0, 0, 1, 1, 0, 1, 1
-});
+// The Rijndael modulus each thread starts with, kept on the heap even if first used inside an arena scope
+static Polynomial defaultModulus(){
+    ArenaSuspend suspend;
+    return Polynomial(vector<Modular<int>>{
+        1, 1, 0, 1, 1, 0, 0, 0, 1
+    });
+}
+
+thread_local Polynomial GaloisPolynomial::_modulus = defaultModulus();
 
 
 
@@ -295,6 +520,7 @@ GaloisPolynomial & GaloisPolynomial::operator-=(const GaloisPolynomial & other){
 
 // Multiply two polynomials mod _modulus
 GaloisPolynomial & GaloisPolynomial::operator*=(const GaloisPolynomial & other){
+    INSTRUMENT_COUNT(galoisMultiplies);
     _polynomial *= other._polynomial;
     _polynomial %= _modulus;
     return *this;
@@ -319,6 +545,7 @@ GaloisPolynomial GaloisPolynomial::operator-(const GaloisPolynomial & other) con
 
 // Multiply two polynomials mod _modulus
 GaloisPolynomial GaloisPolynomial::operator*(const GaloisPolynomial & other) const{
+    INSTRUMENT_COUNT(galoisMultiplies);
     return GaloisPolynomial((_polynomial * other._polynomial) % _modulus);
 }
 
@@ -327,8 +554,41 @@ GaloisPolynomial GaloisPolynomial::operator/(const GaloisPolynomial & other) con
     return GaloisPolynomial((_polynomial * other.inverse()._polynomial) % _modulus);
 }
 
+// Multiply without reducing mod _modulus, for sums of products reduced once
+Polynomial GaloisPolynomial::multiplyUnreduced(const GaloisPolynomial & other) const{
+    return _polynomial * other._polynomial;
+}
+
+// Multiply by x, a shift and at most one subtraction of the modulus
+GaloisPolynomial GaloisPolynomial::timesX() const{
+    INSTRUMENT_COUNT(galoisMultiplies);
+    GaloisPolynomial result(*this);
+    result._polynomial.multiplyByX();
+    if(result._polynomial.size() >= _modulus.size()) result._polynomial %= _modulus;
+    return result;
+}
+
+// The square, spreading coefficients over characteristic 2
+GaloisPolynomial GaloisPolynomial::square() const{
+    INSTRUMENT_COUNT(galoisMultiplies);
+    return GaloisPolynomial(_polynomial.square() % _modulus);
+}
+
+// this^e by sliding window exponentiation
+GaloisPolynomial GaloisPolynomial::pow(const Exponent & e) const{
+    return GaloisPolynomial(_polynomial.powMod(e, _modulus));
+}
+
+// The multiplicative inverse as this^(p^n - 2), a fixed sequence of squares and multiplies
+GaloisPolynomial GaloisPolynomial::inverseByFermat() const{
+    Exponent e = Exponent::power(_modulus.getPrime(), _modulus.size() - 1);
+    e -= 2;
+    return pow(e);
+}
+
 // Find multiplicative inverse mod _modulus
 GaloisPolynomial GaloisPolynomial::inverse() const{
+    INSTRUMENT_COUNT(galoisInverses);
     // Return 0 on 0
     if(_polynomial.size()<1) return GaloisPolynomial(Polynomial(0,_polynomial.getPrime(),1));
     Polynomial p1 = _modulus;
@@ -381,10 +641,17 @@ int GaloisPolynomial::toInt() const{
     return _polynomial.toInt();
 }
 
-// Sets up the galois field for the polynomials
+// Sets up the galois field for the polynomials on the calling thread
 void GaloisPolynomial::globalSetModulus(const Polynomial & modulus){
+    INSTRUMENT_COUNT(galoisModulusWrites);
+    ArenaSuspend suspend;   // The modulus outlives any arena scope
     _modulus = modulus;
 }
 
+// The calling thread's modulus
+const Polynomial & GaloisPolynomial::globalModulus(){
+    return _modulus;
+}
+
 #endif
 
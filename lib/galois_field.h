@@ -18,7 +18,10 @@
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
+#include "arena.h"
+#include "exponent.h"
 #include "modular_arithmetic.h"
+#include "product_sum.h"
 
 using std::vector;
 using std::string;
@@ -27,6 +30,9 @@ using std::max;
 using std::runtime_error;
 using std::to_string;
 
+// Coefficient storage, taken from the thread's arena inside an ArenaScope
+typedef vector<Modular<int>, ArenaAllocator<Modular<int>>> Coefficients;
+
 /*
  * Polynomial
  * Represents a polynomial of the form a_n*x^n+...+a_1*x+a_0
@@ -61,6 +67,16 @@ public:
     // Divide two polynomials (results in lower degree n)
     Polynomial operator/(const Polynomial & other) const;
     
+    // Multiply by x, shifting every coefficient up one place
+    Polynomial & multiplyByX();
+    
+    // The square, which over characteristic 2 just spreads the coefficients to even places
+    Polynomial square() const;
+    // this^e mod modulus by sliding window exponentiation
+    Polynomial powMod(const Exponent & e, const Polynomial & modulus) const;
+    // Monic greatest common divisor by Euclid's algorithm, zero only if both are
+    Polynomial gcd(const Polynomial & other) const;
+    
     // Grab a coefficient from the polynomial
     const Modular<int> & operator[](int i) const;
     
@@ -78,8 +94,14 @@ public:
     
 private:
     void reduce();
-    
-    vector<Modular<int>> _a;
+    // Carry-less product over GF(2) on coefficients packed 64 to a word
+    void multiplyBinary(const Polynomial & other);
+    // Remainder over GF(2) on packed words, folding a sparse modulus in whole words
+    void reduceBinary(const Polynomial & modulus);
+    // Remainder by long division in place, for odd primes
+    void reduceGeneral(const Polynomial & modulus);
+    
+    Coefficients _a;
     int _p;
 };
 
@@ -89,12 +111,19 @@ private:
  * and multiplication mod the modulus polynomial, keeping the degree of
  * the polynomial <= degree of the galois field.  Also allows for
  * calculating the multiplicative inverse mod the modulus polynomial.
+ * 
+ * The modulus is kept per thread, as is Modular<int>'s. A thread
+ * starts in the Rijndael field with no Modular<int> modulus, so a
+ * field set before threads are spawned does not carry into them;
+ * each thread calls globalSetModulus for itself.
  */
 
 class GaloisPolynomial{
 public:
-    // Sets up the galois field for the polynomials
+    // Sets up the galois field for the polynomials on the calling thread, each thread keeps its own
     static void globalSetModulus(const Polynomial & modulus);
+    // The calling thread's modulus
+    static const Polynomial & globalModulus();
     
     GaloisPolynomial(int value = 0, int p = 2, int n = 8);
     GaloisPolynomial(const vector<Modular<int>> & v, int p = 2);
@@ -118,8 +147,19 @@ public:
     // Divide two polynomials mod _modulus
     GaloisPolynomial operator/(const GaloisPolynomial & other) const;
     
+    // Multiply without reducing mod _modulus, for sums of products reduced once
+    Polynomial multiplyUnreduced(const GaloisPolynomial & other) const;
+    // Multiply by x, a shift and at most one subtraction of the modulus
+    GaloisPolynomial timesX() const;
+    // The square, spreading coefficients over characteristic 2
+    GaloisPolynomial square() const;
+    // this^e by sliding window exponentiation
+    GaloisPolynomial pow(const Exponent & e) const;
+    
     // Find the multiplicative inverse
     GaloisPolynomial inverse() const;
+    // The multiplicative inverse as this^(p^n - 2), a fixed sequence of squares and multiplies
+    GaloisPolynomial inverseByFermat() const;
     
     // Grab a coefficient from the polynomial
     const Modular<int> operator[](int i) const;
@@ -136,7 +176,31 @@ public:
     
 private:
     Polynomial _polynomial;
-    static Polynomial _modulus;
+    static thread_local Polynomial _modulus;
+};
+
+/*
+ * ProductSum for GaloisPolynomial
+ * Adds products as plain polynomials of degree below 2n and reduces
+ * mod the field modulus once, instead of after every product.
+ */
+template<>
+class ProductSum<GaloisPolynomial>{
+public:
+    ProductSum(): _sum(0) {}
+    
+    // Adds a * b to the sum without reducing
+    void add(const GaloisPolynomial & a, const GaloisPolynomial & b){
+        _sum += a.multiplyUnreduced(b);
+    }
+    
+    // The sum reduced into the field
+    GaloisPolynomial result() const{
+        return GaloisPolynomial(_sum);
+    }
+    
+private:
+    Polynomial _sum;
 };
 
 #endif
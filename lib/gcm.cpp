@@ -0,0 +1,288 @@
+/*
+ * gcm.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * AES in Galois/Counter Mode (NIST SP 800-38D). The counter
+ * keystream and GHASH run over the same chunk of the message
+ * in one pass, so every byte is encrypted and authenticated
+ * while it is still in cache.
+ */
+
+#ifndef GCM_CPP
+#define GCM_CPP
+
+#include "gcm.h"
+#include "byte_order.h"
+#include <cstring>
+
+// Mod polynomial x^128 + x^7 + x^2 + x + 1 of the GHASH field
+const Polynomial gcm_Mod(vector<Modular<int>>{
+    1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1
+});
+
+// Blocks of keystream generated and hashed per pass
+static const size_t GCM_CHUNK_BLOCKS = 8;
+
+// The hash key H is the encryption of the zero block
+struct GcmHashKey{
+    unsigned char h[16];
+};
+
+static GcmHashKey gcmHashKey(const AesKey & key, AesEngine engine){
+    GcmHashKey hk;
+    unsigned char zero[16] = {0};
+    encryptBlocks(engine, key, zero, hk.h, 1);
+    return hk;
+}
+
+// Increment the last 32 bits of a counter block
+static inline void increment32(unsigned char * counter){
+    for(int i=15; i>=12; i--){
+        if(++counter[i] != 0) break;
+    }
+}
+
+// Hash length bytes of data, zero padding the last block
+static void hashPadded(const Ghash & ghash, unsigned char * y, const unsigned char * data, size_t length){
+    ghash.update(y, data, length / 16);
+    if(length % 16 != 0){
+        unsigned char last[16] = {0};
+        memcpy(last, data + 16*(length/16), length % 16);
+        ghash.update(y, last, 1);
+    }
+}
+
+Gcm::Gcm(const AesKey & key, GhashMethod method, AesEngine engine):
+    _key(key), _engine(resolveEngine(engine)), _ghash(gcmHashKey(key, _engine).h, method) {}
+
+// Derives the pre-counter block J0 from the iv
+void Gcm::counterBlock(const unsigned char * iv, size_t ivLength, unsigned char * j0) const{
+    // A 96 bit iv is used directly with a counter of 1
+    if(ivLength == 12){
+        memcpy(j0, iv, 12);
+        j0[12] = 0;
+        j0[13] = 0;
+        j0[14] = 0;
+        j0[15] = 1;
+        return;
+    }
+    
+    // Any other length is hashed along with its bit length
+    memset(j0, 0, 16);
+    hashPadded(_ghash, j0, iv, ivLength);
+    unsigned char lengths[16] = {0};
+    storeBig64(lengths + 8, (uint64_t) ivLength * 8);
+    _ghash.update(j0, lengths, 1);
+}
+
+// Checks a tag length is one SP 800-38D allows: 12 to 16 bytes, or 8 and 4 for restricted uses
+static void checkTagLength(size_t tagLength){
+    bool allowed = (tagLength >= 12 && tagLength <= 16) || tagLength == 8 || tagLength == 4;
+    if(!allowed) throw runtime_error("GCM tag must be 16, 15, 14, 13, 12, 8 or 4 bytes.");
+}
+
+// Encrypts length bytes of in to out and writes a tagLength byte tag, at most GCM_MAX_LENGTH bytes
+void Gcm::encrypt(const unsigned char * iv, size_t ivLength,
+                  const unsigned char * aad, size_t aadLength,
+                  const unsigned char * in, unsigned char * out, size_t length,
+                  unsigned char * tag, size_t tagLength) const{
+    checkTagLength(tagLength);
+    GcmStream stream(*this, true, iv, ivLength);
+    stream.updateAad(aad, aadLength);
+    stream.update(in, length, out);
+    stream.finalize(tag, tagLength);
+}
+
+// Decrypts length bytes of in to out, returns false and zeroes out if the tag is wrong
+bool Gcm::decrypt(const unsigned char * iv, size_t ivLength,
+                  const unsigned char * aad, size_t aadLength,
+                  const unsigned char * in, unsigned char * out, size_t length,
+                  const unsigned char * tag, size_t tagLength) const{
+    checkTagLength(tagLength);
+    GcmStream stream(*this, false, iv, ivLength);
+    stream.updateAad(aad, aadLength);
+    stream.update(in, length, out);
+    if(!stream.verify(tag, tagLength)){
+        memset(out, 0, length);
+        return false;
+    }
+    return true;
+}
+
+// Returns the GHASH method in use
+GhashMethod Gcm::ghashMethod() const{
+    return _ghash.method();
+}
+
+GcmStream::GcmStream(const Gcm & gcm, bool encrypting, const unsigned char * iv, size_t ivLength):
+    _gcm(gcm), _encrypting(encrypting) {
+    reset(iv, ivLength);
+}
+
+// Adds length bytes of additional data, only before any of the message
+void GcmStream::updateAad(const unsigned char * aad, size_t length){
+    checkOpen();
+    if(length == 0) return;
+    if(_length != 0) throw runtime_error("GCM additional data must come before the message.");
+    if(length > GCM_MAX_AAD_LENGTH - _aadLength) throw runtime_error("GCM additional data is too long.");
+    
+    // Top up a held block, then hash whole blocks straight from aad
+    size_t used = _aadLength % 16;
+    _aadLength += length;
+    if(used != 0){
+        size_t take = 16 - used;
+        if(take > length) take = length;
+        memcpy(_block + used, aad, take);
+        aad += take;
+        length -= take;
+        if(used + take < 16) return;
+        _gcm._ghash.update(_y, _block, 1);
+    }
+    _gcm._ghash.update(_y, aad, length / 16);
+    memcpy(_block, aad + 16*(length/16), length % 16);
+}
+
+// Throws once finalize or verify has ended the message, until reset starts the next
+void GcmStream::checkOpen() const{
+    if(_finished) throw runtime_error("GCM stream is finished, reset starts the next message.");
+}
+
+// Hashes the zero padded tail of the additional data once the message starts
+void GcmStream::finishAad(){
+    size_t used = _aadLength % 16;
+    if(used == 0) return;
+    memset(_block + used, 0, 16 - used);
+    _gcm._ghash.update(_y, _block, 1);
+}
+
+// Encrypts or decrypts length bytes of in to out, which may be the same buffer, throws past GCM_MAX_LENGTH
+void GcmStream::update(const unsigned char * in, size_t length, unsigned char * out){
+    checkOpen();
+    if(length == 0) return;
+    if(length > GCM_MAX_LENGTH - _length) throw runtime_error("GCM message must be at most 2^32 - 2 blocks.");
+    if(_length == 0) finishAad();
+    
+    size_t used = _length % 16;
+    _length += length;
+    
+    // Finish the block the last call started, its ciphertext replaces the keystream it used
+    if(used != 0){
+        size_t take = 16 - used;
+        if(take > length) take = length;
+        for(size_t i=0; i<take; i++){
+            unsigned char c = in[i];
+            out[i] = c ^ _block[used + i];
+            _block[used + i] = _encrypting ? out[i] : c;
+        }
+        in += take;
+        out += take;
+        length -= take;
+        if(used + take < 16) return;
+        _gcm._ghash.update(_y, _block, 1);
+    }
+    
+    // Whole blocks are hashed in the caller's buffer, before decrypting or after encrypting
+    unsigned char counters[16*GCM_CHUNK_BLOCKS];
+    unsigned char keystream[16*GCM_CHUNK_BLOCKS];
+    while(length >= 16){
+        size_t blocks = length / 16;
+        if(blocks > GCM_CHUNK_BLOCKS) blocks = GCM_CHUNK_BLOCKS;
+        for(size_t b=0; b<blocks; b++){
+            increment32(_counter);
+            memcpy(counters + 16*b, _counter, 16);
+        }
+        encryptBlocks(_gcm._engine, _gcm._key, counters, keystream, blocks);
+        
+        if(!_encrypting) _gcm._ghash.update(_y, in, blocks);
+        xorBytes(out, in, keystream, 16*blocks);
+        if(_encrypting) _gcm._ghash.update(_y, out, blocks);
+        
+        in += 16*blocks;
+        out += 16*blocks;
+        length -= 16*blocks;
+    }
+    
+    // A partial block keeps its ciphertext and the rest of its keystream
+    if(length != 0){
+        increment32(_counter);
+        encryptBlocks(_gcm._engine, _gcm._key, _counter, _block, 1);
+        for(size_t i=0; i<length; i++){
+            unsigned char c = in[i];
+            out[i] = c ^ _block[i];
+            _block[i] = _encrypting ? out[i] : c;
+        }
+    }
+}
+
+// Writes the full 16 byte tag and ends the message, the padding and lengths are folded into _y
+void GcmStream::fullTag(unsigned char * tag){
+    checkOpen();
+    _finished = true;
+    if(_length == 0) finishAad();
+    size_t used = _length % 16;
+    if(used != 0){
+        memset(_block + used, 0, 16 - used);
+        _gcm._ghash.update(_y, _block, 1);
+    }
+    
+    unsigned char lengths[16];
+    storeBig64(lengths, _aadLength * 8);
+    storeBig64(lengths + 8, _length * 8);
+    _gcm._ghash.update(_y, lengths, 1);
+    
+    // J0 is the counter less one increment per keystream block, in its last 32 bits
+    unsigned char j0[16];
+    memcpy(j0, _counter, 12);
+    uint64_t low = (loadBig64(_counter + 8) - (_length + 15) / 16) & 0xffffffff;
+    for(int i=0; i<4; i++){
+        j0[12 + i] = (unsigned char) (low >> (24 - 8*i));
+    }
+    
+    // Tag is the hash masked by the encrypted pre-counter block
+    unsigned char mask[16];
+    encryptBlocks(_gcm._engine, _gcm._key, j0, mask, 1);
+    xorBytes(tag, _y, mask, 16);
+}
+
+// Writes the first tagLength bytes of the tag, reset starts the next message
+void GcmStream::finalize(unsigned char * tag, size_t tagLength){
+    checkTagLength(tagLength);
+    unsigned char full[16];
+    fullTag(full);
+    memcpy(tag, full, tagLength);
+}
+
+// Returns true if tag matches the message, compared in constant time
+bool GcmStream::verify(const unsigned char * tag, size_t tagLength){
+    checkTagLength(tagLength);
+    unsigned char full[16];
+    fullTag(full);
+    
+    // Compare without an early exit so timing does not leak the match length
+    unsigned char diff = 0;
+    for(size_t i=0; i<tagLength; i++){
+        diff |= full[i] ^ tag[i];
+    }
+    return diff == 0;
+}
+
+// Drops any input and starts a new message under a new iv
+void GcmStream::reset(const unsigned char * iv, size_t ivLength){
+    if(ivLength == 0) throw runtime_error("GCM iv must not be empty.");
+    _gcm.counterBlock(iv, ivLength, _counter);
+    memset(_y, 0, 16);
+    _aadLength = 0;
+    _length = 0;
+    _finished = false;
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * gcm.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * AES in Galois/Counter Mode (NIST SP 800-38D). The counter
+ * keystream and GHASH run over the same chunk of the message
+ * in one pass, so every byte is encrypted and authenticated
+ * while it is still in cache.
+ */
+
+#ifndef GCM_H
+#define GCM_H
+
+#include "galois_field.h"
+#include "aes_key.h"
+#include "ghash.h"
+
+// Mod polynomial x^128 + x^7 + x^2 + x + 1 of the GHASH field
+extern const Polynomial gcm_Mod;
+
+// Longest message GCM allows, 2^32 - 2 blocks (2^39 - 256 bits)
+static const uint64_t GCM_MAX_LENGTH = ((uint64_t) 1 << 36) - 32;
+// Longest additional data whose bit length fits in 64 bits
+static const uint64_t GCM_MAX_AAD_LENGTH = ((uint64_t) 1 << 61) - 1;
+
+/*
+ * Gcm
+ * Holds an expanded AES key and its hash key tables.
+ * Nothing is modified after construction, so one object may
+ * encrypt and decrypt from many threads at once.
+ */
+class Gcm{
+public:
+    Gcm(const AesKey & key, GhashMethod method = GHASH_AUTO, AesEngine engine = ENGINE_AUTO);
+    
+    // Tags may be 16, 15, 14, 13 or 12 bytes, or 8 or 4 for the restricted uses of SP 800-38D
+    // Encrypts length bytes of in to out and writes a tagLength byte tag, at most GCM_MAX_LENGTH bytes
+    void encrypt(const unsigned char * iv, size_t ivLength,
+                 const unsigned char * aad, size_t aadLength,
+                 const unsigned char * in, unsigned char * out, size_t length,
+                 unsigned char * tag, size_t tagLength = 16) const;
+    // Decrypts length bytes of in to out, returns false and zeroes out if the tag is wrong
+    bool decrypt(const unsigned char * iv, size_t ivLength,
+                 const unsigned char * aad, size_t aadLength,
+                 const unsigned char * in, unsigned char * out, size_t length,
+                 const unsigned char * tag, size_t tagLength = 16) const;
+    
+    // Returns the GHASH method in use
+    GhashMethod ghashMethod() const;
+    
+private:
+    friend class GcmStream;
+    
+    // Derives the pre-counter block J0 from the iv
+    void counterBlock(const unsigned char * iv, size_t ivLength, unsigned char * j0) const;
+    
+    AesKey _key;
+    AesEngine _engine;
+    Ghash _ghash;
+};
+
+/*
+ * GcmStream
+ * Incremental GCM over one message arriving in pieces of any
+ * size. Additional data comes first, then the message; whole
+ * blocks are encrypted and hashed straight from the caller's
+ * buffers, and a partial block keeps its ciphertext and the rest
+ * of its keystream in one 16 byte buffer. The Gcm must outlive
+ * the stream.
+ * 
+ * Decrypted output is released before the tag is checked, so a
+ * caller must discard it if verify fails. finalize or verify ends
+ * the message: any further call throws until reset.
+ */
+class GcmStream{
+public:
+    GcmStream(const Gcm & gcm, bool encrypting, const unsigned char * iv, size_t ivLength);
+    
+    // Adds length bytes of additional data, only before any of the message
+    void updateAad(const unsigned char * aad, size_t length);
+    // Encrypts or decrypts length bytes of in to out, which may be the same buffer, throws past GCM_MAX_LENGTH
+    void update(const unsigned char * in, size_t length, unsigned char * out);
+    // Writes the first tagLength bytes of the tag, reset starts the next message
+    void finalize(unsigned char * tag, size_t tagLength = 16);
+    // Returns true if tag matches the message, compared in constant time
+    bool verify(const unsigned char * tag, size_t tagLength = 16);
+    // Drops any input and starts a new message under a new iv
+    void reset(const unsigned char * iv, size_t ivLength);
+    
+private:
+    // Hashes the zero padded tail of the additional data once the message starts
+    void finishAad();
+    // Throws once finalize or verify has ended the message, until reset starts the next
+    void checkOpen() const;
+    // Writes the full 16 byte tag and ends the message
+    void fullTag(unsigned char * tag);
+    
+    const Gcm & _gcm;
+    bool _encrypting;
+    uint64_t _aadLength;
+    uint64_t _length;
+    bool _finished;             // finalize or verify has run, only reset is allowed
+    unsigned char _y[16];       // Running GHASH digest
+    unsigned char _counter[16]; // Last counter block used, J0 plus one per keystream block
+    unsigned char _block[16];   // Partial block: ciphertext or additional data first, then unused keystream
+};
+
+#endif
@@ -0,0 +1,308 @@
+/*
+ * ghash.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * GHASH, the universal hash of GCM. Blocks are elements of
+ * GF(2^128) mod x^128 + x^7 + x^2 + x + 1, with bit i of the
+ * block (most significant bit of byte 0 first) being the
+ * coefficient of x^i. Multiplication by the hash key H is done
+ * with Shoup's tables or with carry-less multiplication.
+ */
+
+#ifndef GHASH_CPP
+#define GHASH_CPP
+
+#include "ghash.h"
+#include "cpu_features.h"
+#include "byte_order.h"
+
+#ifdef AES_X86
+#include <immintrin.h>
+#define GHASH_CLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+#endif
+
+/*
+ * Reduction tables for Shoup's method. Shifting z right by k bits
+ * multiplies by x^k, the k bits falling off the end are the
+ * coefficients of x^128 ... x^(128+k-1), which fold back in as
+ * multiples of x^128 = x^7 + x^2 + x + 1 (0xe1 bit reflected).
+ */
+struct GhashReduction{
+    uint16_t last4[16];
+    uint16_t last8[256];
+    
+    GhashReduction(){
+        for(int rem=0; rem<256; rem++){
+            uint16_t v = 0;
+            for(int j=0; j<8; j++){
+                if((rem >> j) & 1) v ^= (uint16_t) (0xe100 >> (7-j));
+            }
+            last8[rem] = v;
+        }
+        for(int rem=0; rem<16; rem++){
+            uint16_t v = 0;
+            for(int j=0; j<4; j++){
+                if((rem >> j) & 1) v ^= (uint16_t) (0xe100 >> (3-j));
+            }
+            last4[rem] = v;
+        }
+    }
+};
+
+static const GhashReduction & ghashReduction(){
+    static const GhashReduction table;
+    return table;
+}
+
+// Multiply (vh, vl) by x, a right shift in the bit reflected order
+static inline void multiplyX(uint64_t & vh, uint64_t & vl){
+    uint64_t carry = vl & 1;
+    vl = (vh << 63) | (vl >> 1);
+    vh = (vh >> 1) ^ ((0 - carry) & 0xe100000000000000ULL);
+}
+
+// Byte i of the block held in (zh, zl)
+static inline unsigned int blockByte(uint64_t zh, uint64_t zl, int i){
+    return i < 8 ? (unsigned int) (zh >> (56 - 8*i)) & 0xff : (unsigned int) (zl >> (120 - 8*i)) & 0xff;
+}
+
+// Horner's rule over nibbles, highest degree coefficients first
+static inline void multiplyTable4(const uint64_t * hh, const uint64_t * hl, const uint16_t * last4,
+                                  uint64_t & yh, uint64_t & yl){
+    unsigned int b = blockByte(yh, yl, 15);
+    uint64_t zh = hh[b & 0xf];
+    uint64_t zl = hl[b & 0xf];
+    for(int i=15; i>=0; i--){
+        b = blockByte(yh, yl, i);
+        if(i != 15){
+            unsigned int rem = (unsigned int) zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t) last4[rem] << 48);
+            zh ^= hh[b & 0xf];
+            zl ^= hl[b & 0xf];
+        }
+        unsigned int rem = (unsigned int) zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t) last4[rem] << 48);
+        zh ^= hh[b >> 4];
+        zl ^= hl[b >> 4];
+    }
+    yh = zh;
+    yl = zl;
+}
+
+// Horner's rule over bytes, highest degree coefficients first
+static inline void multiplyTable8(const uint64_t * hh, const uint64_t * hl, const uint16_t * last8,
+                                  uint64_t & yh, uint64_t & yl){
+    unsigned int b = blockByte(yh, yl, 15);
+    uint64_t zh = hh[b];
+    uint64_t zl = hl[b];
+    for(int i=14; i>=0; i--){
+        b = blockByte(yh, yl, i);
+        unsigned int rem = (unsigned int) zl & 0xff;
+        zl = (zh << 56) | (zl >> 8);
+        zh = (zh >> 8) ^ ((uint64_t) last8[rem] << 48);
+        zh ^= hh[b];
+        zl ^= hl[b];
+    }
+    yh = zh;
+    yl = zl;
+}
+
+#ifdef AES_X86
+
+// Reverse the bytes of a block so bit 127 - i is the coefficient of x^i
+GHASH_CLMUL_TARGET static inline __m128i reverseBytes(__m128i v){
+    return _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+// Accumulate the unreduced 256 bit product a*b into lo, mid and hi
+GHASH_CLMUL_TARGET static inline void clmulAccumulate(__m128i a, __m128i b, __m128i & lo, __m128i & mid, __m128i & hi){
+    lo = _mm_xor_si128(lo, _mm_clmulepi64_si128(a, b, 0x00));
+    hi = _mm_xor_si128(hi, _mm_clmulepi64_si128(a, b, 0x11));
+    mid = _mm_xor_si128(mid, _mm_clmulepi64_si128(a, b, 0x10));
+    mid = _mm_xor_si128(mid, _mm_clmulepi64_si128(a, b, 0x01));
+}
+
+// Reduce an accumulated product mod x^128 + x^7 + x^2 + x + 1
+GHASH_CLMUL_TARGET static inline __m128i clmulReduce(__m128i lo, __m128i mid, __m128i hi){
+    __m128i r0 = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    __m128i r1 = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+    
+    // The reflected product is one bit short, shift the 256 bits left by one
+    __m128i c0 = _mm_srli_epi32(r0, 31);
+    __m128i c1 = _mm_srli_epi32(r1, 31);
+    r0 = _mm_slli_epi32(r0, 1);
+    r1 = _mm_slli_epi32(r1, 1);
+    r1 = _mm_or_si128(r1, _mm_srli_si128(c0, 12));
+    r1 = _mm_or_si128(r1, _mm_slli_si128(c1, 4));
+    r0 = _mm_or_si128(r0, _mm_slli_si128(c0, 4));
+    
+    // Fold the low half into the high half in two steps
+    __m128i a = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(r0, 31), _mm_slli_epi32(r0, 30)), _mm_slli_epi32(r0, 25));
+    __m128i carry = _mm_srli_si128(a, 4);
+    r0 = _mm_xor_si128(r0, _mm_slli_si128(a, 12));
+    __m128i b = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(r0, 1), _mm_srli_epi32(r0, 2)), _mm_srli_epi32(r0, 7));
+    b = _mm_xor_si128(b, carry);
+    r0 = _mm_xor_si128(r0, b);
+    return _mm_xor_si128(r1, r0);
+}
+
+// Full multiply of two byte reversed elements
+GHASH_CLMUL_TARGET static inline __m128i clmulMultiply(__m128i a, __m128i b){
+    __m128i lo = _mm_setzero_si128();
+    __m128i mid = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+    clmulAccumulate(a, b, lo, mid, hi);
+    return clmulReduce(lo, mid, hi);
+}
+
+// Store H, H^2, H^3 and H^4 in byte reversed order
+GHASH_CLMUL_TARGET static void clmulPowers(const unsigned char * h, unsigned char (*powers)[16]){
+    __m128i h1 = reverseBytes(_mm_loadu_si128((const __m128i *) h));
+    __m128i hk = h1;
+    for(int k=0; k<4; k++){
+        _mm_storeu_si128((__m128i *) powers[k], hk);
+        hk = clmulMultiply(hk, h1);
+    }
+}
+
+/*
+ * Four blocks at a time the digest is
+ *   ((((y + x1)H + x2)H + x3)H + x4)H = (y + x1)H^4 + x2 H^3 + x3 H^2 + x4 H
+ * so the four products are summed unreduced and reduced once.
+ */
+GHASH_CLMUL_TARGET static void updateClmul(const unsigned char (*powers)[16], unsigned char * y,
+                                           const unsigned char * x, size_t blocks){
+    __m128i h1 = _mm_loadu_si128((const __m128i *) powers[0]);
+    __m128i h2 = _mm_loadu_si128((const __m128i *) powers[1]);
+    __m128i h3 = _mm_loadu_si128((const __m128i *) powers[2]);
+    __m128i h4 = _mm_loadu_si128((const __m128i *) powers[3]);
+    __m128i acc = reverseBytes(_mm_loadu_si128((const __m128i *) y));
+    
+    while(blocks >= 4){
+        __m128i x1 = reverseBytes(_mm_loadu_si128((const __m128i *) x));
+        __m128i x2 = reverseBytes(_mm_loadu_si128((const __m128i *) (x + 16)));
+        __m128i x3 = reverseBytes(_mm_loadu_si128((const __m128i *) (x + 32)));
+        __m128i x4 = reverseBytes(_mm_loadu_si128((const __m128i *) (x + 48)));
+        __m128i lo = _mm_setzero_si128();
+        __m128i mid = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+        clmulAccumulate(_mm_xor_si128(acc, x1), h4, lo, mid, hi);
+        clmulAccumulate(x2, h3, lo, mid, hi);
+        clmulAccumulate(x3, h2, lo, mid, hi);
+        clmulAccumulate(x4, h1, lo, mid, hi);
+        acc = clmulReduce(lo, mid, hi);
+        x += 64;
+        blocks -= 4;
+    }
+    
+    while(blocks > 0){
+        __m128i x1 = reverseBytes(_mm_loadu_si128((const __m128i *) x));
+        acc = clmulMultiply(_mm_xor_si128(acc, x1), h1);
+        x += 16;
+        blocks -= 1;
+    }
+    
+    _mm_storeu_si128((__m128i *) y, reverseBytes(acc));
+}
+
+#endif
+
+Ghash::Ghash(const unsigned char * h, GhashMethod method){
+    if(method == GHASH_AUTO) method = cpuHasClmul() ? GHASH_CLMUL : GHASH_TABLE8;
+    if(method == GHASH_CLMUL && !cpuHasClmul()) method = GHASH_TABLE8;
+    _method = method;
+    
+    uint64_t hh = loadBig64(h);
+    uint64_t hl = loadBig64(h + 8);
+    switch(_method){
+        case GHASH_TABLE4:
+            buildTable4(hh, hl);
+            break;
+        case GHASH_TABLE8:
+            buildTable8(hh, hl);
+            break;
+        default:
+            buildClmul(h);
+            break;
+    }
+}
+
+// Entry 8 is H, entries 4, 2, 1 are H*x, H*x^2, H*x^3, the rest are sums
+void Ghash::buildTable4(uint64_t hh, uint64_t hl){
+    _hh.assign(16, 0);
+    _hl.assign(16, 0);
+    _hh[8] = hh;
+    _hl[8] = hl;
+    for(int i=4; i>0; i>>=1){
+        multiplyX(hh, hl);
+        _hh[i] = hh;
+        _hl[i] = hl;
+    }
+    for(int i=2; i<16; i<<=1){
+        for(int j=1; j<i; j++){
+            _hh[i+j] = _hh[i] ^ _hh[j];
+            _hl[i+j] = _hl[i] ^ _hl[j];
+        }
+    }
+}
+
+// Entry 128 is H, entries 64 ... 1 are H*x ... H*x^7, the rest are sums
+void Ghash::buildTable8(uint64_t hh, uint64_t hl){
+    _hh.assign(256, 0);
+    _hl.assign(256, 0);
+    _hh[128] = hh;
+    _hl[128] = hl;
+    for(int i=64; i>0; i>>=1){
+        multiplyX(hh, hl);
+        _hh[i] = hh;
+        _hl[i] = hl;
+    }
+    for(int i=2; i<256; i<<=1){
+        for(int j=1; j<i; j++){
+            _hh[i+j] = _hh[i] ^ _hh[j];
+            _hl[i+j] = _hl[i] ^ _hl[j];
+        }
+    }
+}
+
+// Powers of H for aggregated reduction
+void Ghash::buildClmul(const unsigned char * h){
+#ifdef AES_X86
+    clmulPowers(h, _powers);
+#endif
+}
+
+// Sets y = (y + x_i) * H for each 16 byte block x_i in turn
+void Ghash::update(unsigned char * y, const unsigned char * x, size_t blocks) const{
+#ifdef AES_X86
+    if(_method == GHASH_CLMUL){
+        updateClmul(_powers, y, x, blocks);
+        return;
+    }
+#endif
+    
+    const GhashReduction & r = ghashReduction();
+    const uint64_t * hh = _hh.data();
+    const uint64_t * hl = _hl.data();
+    uint64_t yh = loadBig64(y);
+    uint64_t yl = loadBig64(y + 8);
+    for(size_t i=0; i<blocks; i++){
+        yh ^= loadBig64(x);
+        yl ^= loadBig64(x + 8);
+        if(_method == GHASH_TABLE4) multiplyTable4(hh, hl, r.last4, yh, yl);
+        else multiplyTable8(hh, hl, r.last8, yh, yl);
+        x += 16;
+    }
+    storeBig64(y, yh);
+    storeBig64(y + 8, yl);
+}
+
+// Returns the method actually in use
+GhashMethod Ghash::method() const{
+    return _method;
+}
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * ghash.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * GHASH, the universal hash of GCM. Blocks are elements of
+ * GF(2^128) mod x^128 + x^7 + x^2 + x + 1, with bit i of the
+ * block (most significant bit of byte 0 first) being the
+ * coefficient of x^i. Multiplication by the hash key H is done
+ * with Shoup's tables or with carry-less multiplication.
+ */
+
+#ifndef GHASH_H
+#define GHASH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+using std::uint64_t;
+using std::uint16_t;
+using std::size_t;
+using std::vector;
+
+enum GhashMethod{
+    GHASH_AUTO,     // Fastest method the processor supports
+    GHASH_TABLE4,   // Shoup's method with 4 bit tables (256 bytes)
+    GHASH_TABLE8,   // Shoup's method with 8 bit tables (4 kilobytes)
+    GHASH_CLMUL     // Carry-less multiply, reducing once per 4 blocks
+};
+
+/*
+ * Ghash
+ * Precomputed multiples of a hash key H, only those the method
+ * uses. The running digest is passed in by the caller, so one
+ * object can be shared read only by any number of messages and
+ * threads.
+ */
+class Ghash{
+public:
+    Ghash(const unsigned char * h, GhashMethod method = GHASH_AUTO);
+    
+    // Sets y = (y + x_i) * H for each 16 byte block x_i in turn
+    void update(unsigned char * y, const unsigned char * x, size_t blocks) const;
+    
+    // Returns the method actually in use
+    GhashMethod method() const;
+    
+private:
+    void buildTable4(uint64_t hh, uint64_t hl);
+    void buildTable8(uint64_t hh, uint64_t hl);
+    void buildClmul(const unsigned char * h);
+    
+    GhashMethod _method;
+    // Multiples of H indexed by nibble or byte, high and low halves, empty for carry-less multiply
+    vector<uint64_t> _hh, _hl;
+    // H, H^2, H^3, H^4 in byte reversed order for carry-less multiply
+    unsigned char _powers[4][16];
+};
+
+#endif
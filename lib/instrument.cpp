@@ -0,0 +1,72 @@
+/*
+ * instrument.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Opt in operation counters and stage timings for the polynomial
+ * implementation.
+ */
+
+#ifndef INSTRUMENT_CPP
+#define INSTRUMENT_CPP
+
+#include "instrument.h"
+
+// Counters are per thread so the math path can run on many threads without sharing them
+static thread_local InstrumentCounters counters = {};
+
+// True when the library was built with AES_INSTRUMENT
+bool instrumentEnabled(){
+#ifdef AES_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+// The calling thread's counters
+InstrumentCounters & instrumentCounters(){
+    return counters;
+}
+
+// Zeros the calling thread's counters
+void resetInstrumentation(){
+    counters = InstrumentCounters();
+}
+
+// Writes one counter if it is nonzero
+static void dumpCounter(ostream & out, const char * name, size_t value){
+    if(value != 0) out << "  " << name << ": " << value << "\n";
+}
+
+// Writes the calling thread's nonzero counters and stage times
+void dumpInstrumentation(ostream & out){
+    if(!instrumentEnabled()){
+        out << "Instrumentation is not built in, rebuild with -DAES_INSTRUMENT.\n";
+        return;
+    }
+    
+    out << "operations:\n";
+    dumpCounter(out, "Modular arithmetic", counters.modularOps);
+    dumpCounter(out, "Modular mulInverse", counters.modularInverses);
+    dumpCounter(out, "Modular globalSetModulus", counters.modularModulusWrites);
+    dumpCounter(out, "Polynomial built", counters.polynomialsBuilt);
+    dumpCounter(out, "Polynomial *=", counters.polynomialMultiplies);
+    dumpCounter(out, "Polynomial %=", counters.polynomialReductions);
+    dumpCounter(out, "Polynomial /=", counters.polynomialDivisions);
+    dumpCounter(out, "GaloisPolynomial *=", counters.galoisMultiplies);
+    dumpCounter(out, "GaloisPolynomial inverse", counters.galoisInverses);
+    dumpCounter(out, "GaloisPolynomial globalSetModulus", counters.galoisModulusWrites);
+    dumpCounter(out, "QSMatrix built", counters.matricesBuilt);
+    dumpCounter(out, "QSMatrix multiply", counters.matrixMultiplies);
+    
+    const char * stages[INSTRUMENT_STAGES] = { "subBytes", "shiftRows", "mixColumns", "addRoundKey", "expandKey" };
+    out << "stages:\n";
+    for(int s=0; s<INSTRUMENT_STAGES; s++){
+        if(counters.stageCalls[s] == 0) continue;
+        out << "  " << stages[s] << ": " << counters.stageCalls[s] << " calls, "
+            << counters.stageNanoseconds[s] / 1000 << " us\n";
+    }
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * instrument.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Opt in operation counters and stage timings for the polynomial
+ * implementation. Build with -DAES_INSTRUMENT to turn them on;
+ * otherwise the macros expand to nothing and the math path is
+ * compiled exactly as before.
+ */
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <cstddef>
+#include <ostream>
+
+#ifdef AES_INSTRUMENT
+#include <chrono>
+#endif
+
+using std::size_t;
+using std::ostream;
+
+// Steps of the cipher that are timed, inverses count with their forward step
+enum InstrumentStage{
+    STAGE_SUB_BYTES,
+    STAGE_SHIFT_ROWS,
+    STAGE_MIX_COLUMNS,
+    STAGE_ADD_ROUND_KEY,
+    STAGE_EXPAND_KEY,
+    INSTRUMENT_STAGES
+};
+
+/*
+ * InstrumentCounters
+ * Counts for the calling thread since the last reset. Every
+ * Polynomial and QSMatrix built owns heap vectors, so those
+ * counts stand in for allocations.
+ */
+struct InstrumentCounters{
+    size_t modularOps;              // Modular add, subtract, multiply and divide
+    size_t modularInverses;         // Modular mulInverse calls
+    size_t modularModulusWrites;    // Modular globalSetModulus calls
+    size_t polynomialsBuilt;        // Polynomial constructions and copies
+    size_t polynomialMultiplies;    // Polynomial *=
+    size_t polynomialReductions;    // Polynomial %=
+    size_t polynomialDivisions;     // Polynomial /=
+    size_t galoisMultiplies;        // GaloisPolynomial *=
+    size_t galoisInverses;          // GaloisPolynomial inverse calls
+    size_t galoisModulusWrites;     // GaloisPolynomial globalSetModulus calls
+    size_t matricesBuilt;           // QSMatrix constructions and copies
+    size_t matrixMultiplies;        // QSMatrix products
+    size_t stageCalls[INSTRUMENT_STAGES];
+    size_t stageNanoseconds[INSTRUMENT_STAGES];
+};
+
+// True when the library was built with AES_INSTRUMENT
+bool instrumentEnabled();
+// The calling thread's counters, all zero when instrumentation is off
+InstrumentCounters & instrumentCounters();
+// Zeros the calling thread's counters
+void resetInstrumentation();
+// Writes the calling thread's nonzero counters and stage times
+void dumpInstrumentation(ostream & out);
+
+#ifdef AES_INSTRUMENT
+
+/*
+ * StageTimer
+ * Adds the time from construction to destruction to one stage.
+ */
+class StageTimer{
+public:
+    explicit StageTimer(InstrumentStage stage): _stage(stage), _start(std::chrono::steady_clock::now()) {}
+    ~StageTimer(){
+        InstrumentCounters & c = instrumentCounters();
+        c.stageCalls[_stage]++;
+        c.stageNanoseconds[_stage] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - _start).count();
+    }
+
+private:
+    InstrumentStage _stage;
+    std::chrono::steady_clock::time_point _start;
+};
+
+// Bumps one counter of the calling thread
+#define INSTRUMENT_COUNT(counter) (instrumentCounters().counter++)
+// Times the rest of the enclosing scope as one call of a stage
+#define INSTRUMENT_STAGE(stage) StageTimer instrumentStageTimer(stage)
+
+#else
+
+#define INSTRUMENT_COUNT(counter) ((void) 0)
+#define INSTRUMENT_STAGE(stage) ((void) 0)
+
+#endif
+
+#endif
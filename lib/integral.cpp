@@ -0,0 +1,177 @@
+/*
+ * integral.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Reduced round experiments with integral (square) properties:
+ * balance counts over lambda sets and the four round attack.
+ */
+
+#ifndef INTEGRAL_CPP
+#define INTEGRAL_CPP
+
+#include "integral.h"
+#include "aes_tables.h"
+#include "byte_order.h"
+#include "parallel.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+typedef std::chrono::steady_clock Clock;
+
+// Lambda sets added at a time while key bytes still have several candidates, and the most used
+static const int ATTACK_SETS_STEP = 2;
+static const int ATTACK_SETS_MAX = 16;
+
+// splitmix64, a cheap independent stream for each set so results do not depend on the thread count
+static uint64_t nextRandom(uint64_t & state){
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Fills 16 bytes from the stream
+static void randomBlock(uint64_t & state, unsigned char * block){
+    storeLittle64(block, nextRandom(state));
+    storeLittle64(block + 8, nextRandom(state));
+}
+
+// Seconds since start
+static double secondsSince(Clock::time_point start){
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Fills out with the 256 blocks of base with byte active set to each value in turn
+void lambdaSet(const unsigned char * base, int active, unsigned char * out){
+    if(active < 0 || active >= AES_BLOCK_SIZE) throw runtime_error("Active byte out of range.");
+    for(int v=0; v<LAMBDA_SET_SIZE; v++){
+        memcpy(out + AES_BLOCK_SIZE*v, base, AES_BLOCK_SIZE);
+        out[AES_BLOCK_SIZE*v + active] = (unsigned char) v;
+    }
+}
+
+// Bit i is set if byte i of the blocks sums to zero over the set
+unsigned balancedBytes(const unsigned char * blocks){
+    unsigned char sum[AES_BLOCK_SIZE] = {0};
+    for(int v=0; v<LAMBDA_SET_SIZE; v++){
+        xorBytes(sum, sum, blocks + AES_BLOCK_SIZE*v, AES_BLOCK_SIZE);
+    }
+    unsigned mask = 0;
+    for(int i=0; i<AES_BLOCK_SIZE; i++){
+        if(sum[i] == 0) mask |= 1u << i;
+    }
+    return mask;
+}
+
+// Encrypts sets random lambda sets, each under a fresh random key, and counts balanced outputs
+IntegralResult integralTest(int rounds, size_t sets, int threads, AesEngine engine, uint64_t seed){
+    IntegralResult result = {};
+    result.rounds = rounds;
+    result.sets = sets;
+    result.encryptions = sets * LAMBDA_SET_SIZE;
+    std::atomic<size_t> balancedSets(0), balancedByteCount(0);
+    
+    Clock::time_point start = Clock::now();
+    parallelFor(sets, threads, [&](size_t begin, size_t end){
+        unsigned char in[AES_BLOCK_SIZE*LAMBDA_SET_SIZE], out[AES_BLOCK_SIZE*LAMBDA_SET_SIZE];
+        size_t setCount = 0, byteCount = 0;
+        for(size_t i=begin; i<end; i++){
+            uint64_t state = seed ^ (i * 0xd1b54a32d192ed03ULL);
+            unsigned char key[16], base[16];
+            randomBlock(state, key);
+            randomBlock(state, base);
+            AesKey expanded(key, 16, rounds);
+            
+            lambdaSet(base, nextRandom(state) % AES_BLOCK_SIZE, in);
+            encryptBlocks(engine, expanded, in, out, LAMBDA_SET_SIZE);
+            unsigned mask = balancedBytes(out);
+            if(mask == 0xffff) setCount++;
+            byteCount += __builtin_popcount(mask);
+        }
+        balancedSets += setCount;
+        balancedByteCount += byteCount;
+    });
+    result.seconds = secondsSince(start);
+    result.balancedSets = balancedSets;
+    result.balancedBytes = balancedByteCount;
+    return result;
+}
+
+// Recovers an AES-128 key from an oracle for four rounds by the square attack
+SquareAttackResult squareAttack(const EncryptionOracle & oracle, int threads){
+    SquareAttackResult result = {};
+    Clock::time_point start = Clock::now();
+    const AesTables & t = aesTables();
+    
+    // After three rounds every byte is balanced, so undoing the last round's S-Box under the
+    // right guess of a last round key byte must give bytes that sum to zero
+    vector<vector<unsigned char>> ciphertexts;
+    bool candidates[AES_BLOCK_SIZE][256];
+    int remaining[AES_BLOCK_SIZE];
+    for(int i=0; i<AES_BLOCK_SIZE; i++){
+        for(int k=0; k<256; k++) candidates[i][k] = true;
+        remaining[i] = 256;
+    }
+    
+    uint64_t state = 4;
+    bool settled = false;
+    while(!settled && (int) ciphertexts.size() < ATTACK_SETS_MAX){
+        size_t first = ciphertexts.size();
+        for(int s=0; s<ATTACK_SETS_STEP; s++){
+            unsigned char base[16], in[AES_BLOCK_SIZE*LAMBDA_SET_SIZE];
+            randomBlock(state, base);
+            lambdaSet(base, 0, in);
+            ciphertexts.push_back(vector<unsigned char>(sizeof(in)));
+            oracle(in, ciphertexts.back().data(), LAMBDA_SET_SIZE);
+        }
+        
+        // Key bytes are independent, each thread filters some of them against the new sets
+        parallelFor(AES_BLOCK_SIZE, threads, [&](size_t begin, size_t end){
+            for(size_t i=begin; i<end; i++){
+                for(int k=0; k<256; k++){
+                    if(!candidates[i][k]) continue;
+                    for(size_t s=first; s<ciphertexts.size() && candidates[i][k]; s++){
+                        unsigned char sum = 0;
+                        for(int v=0; v<LAMBDA_SET_SIZE; v++){
+                            sum ^= t.sbox_inverse[ciphertexts[s][AES_BLOCK_SIZE*v + i] ^ k];
+                        }
+                        if(sum != 0){
+                            candidates[i][k] = false;
+                            remaining[i]--;
+                        }
+                    }
+                }
+            }
+        });
+        
+        settled = true;
+        for(int i=0; i<AES_BLOCK_SIZE; i++){
+            if(remaining[i] != 1) settled = false;
+        }
+    }
+    result.lambdaSets = ciphertexts.size();
+    result.encryptions = ciphertexts.size() * LAMBDA_SET_SIZE;
+    
+    if(settled){
+        unsigned char lastKey[16];
+        for(int i=0; i<AES_BLOCK_SIZE; i++){
+            for(int k=0; k<256; k++){
+                if(candidates[i][k]) lastKey[i] = (unsigned char) k;
+            }
+        }
+        firstKeyBytes(lastKey, 16, 4, result.key);
+        
+        // Confirm against the oracle on a fresh block
+        unsigned char block[16], expected[16], actual[16];
+        randomBlock(state, block);
+        oracle(block, expected, 1);
+        encryptBlocks(ENGINE_TABLE, AesKey(result.key, 16, 4), block, actual, 1);
+        result.found = memcmp(expected, actual, 16) == 0;
+    }
+    result.seconds = secondsSince(start);
+    return result;
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ * integral.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ *
+ * Reduced round experiments with integral (square) properties.
+ * A lambda set is 256 plaintexts equal except in one byte, which
+ * takes every value. Through three rounds every byte of the
+ * state still sums to zero over the set, which distinguishes
+ * reduced AES from a random permutation and, one round further
+ * on, lets the last round key be found byte by byte.
+ *
+ * Lambda sets run through the batched engines 256 blocks at a
+ * time, and independent sets or key bytes are split across
+ * threads.
+ */
+
+#ifndef INTEGRAL_H
+#define INTEGRAL_H
+
+#include "aes_key.h"
+#include <cstdint>
+#include <functional>
+
+using std::function;
+using std::uint64_t;
+
+// Plaintexts in a lambda set
+const int LAMBDA_SET_SIZE = 256;
+
+/*
+ * IntegralResult
+ * Counts from encrypting many random lambda sets under random
+ * keys, with the time taken.
+ */
+struct IntegralResult{
+    int rounds;
+    size_t sets;
+    size_t balancedSets;        // Sets where all 16 output bytes sum to zero
+    size_t balancedBytes;       // Output bytes summing to zero, over every set
+    size_t encryptions;
+    double seconds;
+};
+
+/*
+ * SquareAttackResult
+ * The cipher key recovered from a four round oracle, and what it
+ * cost. found is false if some key byte kept several candidates.
+ */
+struct SquareAttackResult{
+    bool found;
+    unsigned char key[16];
+    size_t lambdaSets;
+    size_t encryptions;
+    double seconds;
+};
+
+// Encrypts blocks under a key unknown to the attack
+typedef function<void(const unsigned char * in, unsigned char * out, size_t blocks)> EncryptionOracle;
+
+// Fills out with the 256 blocks of base with byte active set to each value in turn
+void lambdaSet(const unsigned char * base, int active, unsigned char * out);
+// Bit i is set if byte i of the blocks sums to zero over the set
+unsigned balancedBytes(const unsigned char * blocks);
+
+// Encrypts sets random lambda sets, each under a fresh random key, and counts balanced outputs
+IntegralResult integralTest(int rounds, size_t sets, int threads = 0, AesEngine engine = ENGINE_AUTO, uint64_t seed = 1);
+// Recovers an AES-128 key from an oracle for four rounds by the square attack
+SquareAttackResult squareAttack(const EncryptionOracle & oracle, int threads = 0);
+
+#endif
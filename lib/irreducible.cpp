@@ -0,0 +1,358 @@
+/*
+ * irreducible.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Rabin and Ben-Or irreducibility tests, primitivity, and
+ * parallel enumeration of irreducible and primitive polynomials.
+ */
+
+#ifndef IRREDUCIBLE_CPP
+#define IRREDUCIBLE_CPP
+
+#include "irreducible.h"
+#include "arena.h"
+#include "parallel.h"
+#include <algorithm>
+
+using std::uint32_t;
+
+// Pieces the enumerators split candidates into, so threads finish together and results stay in order
+static const size_t ENUMERATE_PIECES = 256;
+
+// a * b mod m for 64 bit values
+static uint64_t multiplyMod64(uint64_t a, uint64_t b, uint64_t m){
+    return (uint64_t) ((unsigned __int128) a * b % m);
+}
+
+// a^e mod m for 64 bit values
+static uint64_t powerMod64(uint64_t a, uint64_t e, uint64_t m){
+    uint64_t r = 1 % m;
+    a %= m;
+    while(e != 0){
+        if(e & 1) r = multiplyMod64(r, a, m);
+        a = multiplyMod64(a, a, m);
+        e >>= 1;
+    }
+    return r;
+}
+
+// Miller-Rabin with the bases that decide every 64 bit number
+static bool isPrime64(uint64_t n){
+    if(n < 2) return false;
+    static const uint64_t bases[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+    for(uint64_t b : bases){
+        if(n % b == 0) return n == b;
+    }
+    uint64_t d = n - 1;
+    int s = 0;
+    while((d & 1) == 0){
+        d >>= 1;
+        s++;
+    }
+    for(uint64_t b : bases){
+        uint64_t x = powerMod64(b, d, n);
+        if(x == 1 || x == n - 1) continue;
+        bool composite = true;
+        for(int i=1; i<s && composite; i++){
+            x = multiplyMod64(x, x, n);
+            if(x == n - 1) composite = false;
+        }
+        if(composite) return false;
+    }
+    return true;
+}
+
+// Greatest common divisor of two 64 bit values
+static uint64_t gcd64(uint64_t a, uint64_t b){
+    while(b != 0){
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// A nontrivial factor of an odd composite n by Pollard's rho with Brent's cycle finding
+static uint64_t rhoFactor(uint64_t n){
+    for(uint64_t c=1; ; c++){
+        uint64_t y = 2, x = 2, g = 1, q = 1, saved = 2;
+        const uint64_t batch = 128;
+        for(uint64_t r=1; g == 1; r <<= 1){
+            x = y;
+            for(uint64_t i=0; i<r; i++) y = (multiplyMod64(y, y, n) + c) % n;
+            for(uint64_t k=0; k<r && g == 1; k+=batch){
+                saved = y;
+                for(uint64_t i=0; i<batch && i<r-k; i++){
+                    y = (multiplyMod64(y, y, n) + c) % n;
+                    q = multiplyMod64(q, x > y ? x - y : y - x, n);
+                }
+                g = gcd64(q, n);
+            }
+        }
+        // The batched product overshot to 0, so step back one at a time
+        if(g == n){
+            g = 1;
+            while(g == 1){
+                saved = (multiplyMod64(saved, saved, n) + c) % n;
+                g = gcd64(x > saved ? x - saved : saved - x, n);
+            }
+        }
+        if(g != n) return g;
+    }
+}
+
+// Adds the prime factors of n to factors, with repeats
+static void factorInto(uint64_t n, vector<uint64_t> & factors){
+    for(uint64_t d=2; d<1000 && d*d<=n; d++){
+        while(n % d == 0){
+            factors.push_back(d);
+            n /= d;
+        }
+    }
+    if(n == 1) return;
+    if(isPrime64(n)){
+        factors.push_back(n);
+        return;
+    }
+    uint64_t d = rhoFactor(n);
+    factorInto(d, factors);
+    factorInto(n / d, factors);
+}
+
+// Distinct prime factors of n, smallest first
+static vector<uint64_t> primeFactors(uint64_t n){
+    vector<uint64_t> factors;
+    factorInto(n, factors);
+    std::sort(factors.begin(), factors.end());
+    factors.erase(std::unique(factors.begin(), factors.end()), factors.end());
+    return factors;
+}
+
+// p^n, or 0 if it does not fit in 64 bits
+static uint64_t fieldOrder(int p, int n){
+    uint64_t q = 1;
+    for(int i=0; i<n; i++){
+        if(q > UINT64_MAX / p) return 0;
+        q *= p;
+    }
+    return q;
+}
+
+// Checks the characteristic and degree the tests accept
+static void checkField(int p, int n){
+    if(p < 2 || p > IRREDUCIBLE_MAX_PRIME || !isPrime64(p)) throw runtime_error("Characteristic must be a prime below " + to_string(IRREDUCIBLE_MAX_PRIME + 1) + ".");
+    if(n < 1) throw runtime_error("Polynomial must have degree at least 1.");
+}
+
+// f with its coefficients reduced into [0, p), checking its characteristic and degree
+static Polynomial normalized(const Polynomial & f){
+    int p = f.getPrime();
+    vector<Modular<int>> c(f.size(), 0);
+    for(int i=0; i<f.size(); i++) c[i] = Modular<int>((f[i].value() % p + p) % p);
+    Polynomial g(c, p);
+    checkField(p, g.size() - 1);
+    return g;
+}
+
+// x mod f, where every test starts
+static Polynomial xModulo(const Polynomial & f){
+    return Polynomial(vector<Modular<int>>{ 0, 1 }, f.getPrime()) % f;
+}
+
+// Whether a and f share no factor
+static bool coprime(const Polynomial & a, const Polynomial & f){
+    return f.gcd(a).size() == 1;
+}
+
+// Rabin: f is irreducible iff x^(p^n) = x mod f and x^(p^(n/r)) - x is coprime to f for each prime r | n
+static bool rabinTest(const Polynomial & f){
+    int n = f.size() - 1;
+    vector<bool> check(n + 1, false);
+    vector<uint64_t> factors = primeFactors(n);
+    for(size_t i=0; i<factors.size(); i++) check[n / factors[i]] = true;
+    
+    Exponent p((uint64_t) f.getPrime());
+    Polynomial x = xModulo(f), h = x;
+    for(int k=1; k<=n; k++){
+        h = h.powMod(p, f);
+        if(k < n && check[k] && !coprime(h - x, f)) return false;
+    }
+    return (h - x).size() == 0;
+}
+
+// Ben-Or: f is irreducible iff x^(p^i) - x is coprime to f for every i up to n/2, so small factors show early
+static bool benOrTest(const Polynomial & f){
+    Exponent p((uint64_t) f.getPrime());
+    Polynomial x = xModulo(f), h = x;
+    for(int i=1; i<=(f.size() - 1)/2; i++){
+        h = h.powMod(p, f);
+        if(!coprime(h - x, f)) return false;
+    }
+    return true;
+}
+
+// For irreducible f, whether x has order q - 1 given the prime factors of q - 1
+static bool generatesField(const Polynomial & f, uint64_t q, const vector<uint64_t> & factors){
+    Polynomial x = xModulo(f);
+    if(x.size() == 0) return false;
+    for(size_t i=0; i<factors.size(); i++){
+        Polynomial r = x.powMod(Exponent((q - 1) / factors[i]), f);
+        if(r.size() == 1 && r[0].value() == 1) return false;
+    }
+    return true;
+}
+
+// p^n - 1 for primitivity, which must fit in 64 bits to be factored
+static uint64_t primitiveOrder(int p, int n){
+    uint64_t q = fieldOrder(p, n);
+    if(q == 0) throw runtime_error("Primitivity needs p^n - 1 to fit in 64 bits.");
+    return q;
+}
+
+// Polynomial with the given coefficients, lowest first
+static Polynomial toPolynomial(int p, const vector<uint32_t> & c){
+    vector<Modular<int>> a;
+    for(size_t i=0; i<c.size(); i++) a.push_back(Modular<int>((int) c[i]));
+    return Polynomial(a, p);
+}
+
+// Whether the candidate with coefficients c is irreducible, and primitive if asked, in the thread's arena
+static bool accepts(int p, const vector<uint32_t> & c, bool primitive, uint64_t q, const vector<uint64_t> & orderFactors){
+    ArenaScope arena;
+    Polynomial f = toPolynomial(p, c);
+    return benOrTest(f) && (!primitive || generatesField(f, q, orderFactors));
+}
+
+// Whether f, of degree at least 1, is irreducible over GF(p), by Rabin's test
+bool isIrreducible(const Polynomial & f){
+    ArenaScope arena;
+    return rabinTest(normalized(f));
+}
+
+// Whether f is irreducible over GF(p), by Ben-Or's test
+bool isIrreducibleBenOr(const Polynomial & f){
+    ArenaScope arena;
+    return benOrTest(normalized(f));
+}
+
+// Whether f is primitive, irreducible with x generating every nonzero element
+bool isPrimitive(const Polynomial & f){
+    ArenaScope arena;
+    Polynomial g = normalized(f);
+    uint64_t q = primitiveOrder(g.getPrime(), g.size() - 1);
+    return rabinTest(g) && generatesField(g, q, primeFactors(q - 1));
+}
+
+// Number of monic irreducible polynomials of degree n over GF(p), (1/n) sum over d | n of mu(d) p^(n/d)
+uint64_t countIrreducible(int p, int n){
+    checkField(p, n);
+    if(fieldOrder(p, n) == 0 || fieldOrder(p, n) > (uint64_t) INT64_MAX) throw runtime_error("Count does not fit in 64 bits.");
+    int64_t sum = 0;
+    for(int d=1; d<=n; d++){
+        if(n % d != 0) continue;
+        vector<uint64_t> factors;
+        factorInto(d, factors);
+        bool squareFree = std::adjacent_find(factors.begin(), factors.end()) == factors.end();
+        if(!squareFree) continue;
+        int64_t term = (int64_t) fieldOrder(p, n / d);
+        sum += factors.size() % 2 == 0 ? term : -term;
+    }
+    return (uint64_t) sum / n;
+}
+
+// Number of monic primitive polynomials of degree n over GF(p), phi(p^n - 1) / n
+uint64_t countPrimitive(int p, int n){
+    checkField(p, n);
+    uint64_t m = primitiveOrder(p, n) - 1, phi = m;
+    vector<uint64_t> factors = primeFactors(m);
+    for(size_t i=0; i<factors.size(); i++) phi = phi / factors[i] * (factors[i] - 1);
+    return phi / n;
+}
+
+// Tests every monic polynomial of degree n, split into pieces across threads
+static vector<Polynomial> enumerate(int p, int n, int threads, bool primitive){
+    checkField(p, n);
+    uint64_t count = fieldOrder(p, n);
+    if(count == 0 || count > IRREDUCIBLE_MAX_CANDIDATES) throw runtime_error("Too many candidates to enumerate.");
+    uint64_t q = primitive ? primitiveOrder(p, n) : 0;
+    vector<uint64_t> orderFactors = primitive ? primeFactors(q - 1) : vector<uint64_t>();
+    
+    // Candidate i has the base p digits of i below the leading 1
+    size_t pieces = (size_t) std::min<uint64_t>(count, ENUMERATE_PIECES);
+    vector<vector<vector<uint32_t>>> found(pieces);
+    parallelFor(pieces, threads, [&](size_t begin, size_t end){
+        for(size_t piece=begin; piece<end; piece++){
+            uint64_t first = count * piece / pieces, last = count * (piece + 1) / pieces;
+            vector<uint32_t> f(n + 1, 0);
+            f[n] = 1;
+            uint64_t digits = first;
+            for(int i=0; i<n; i++){
+                f[i] = (uint32_t) (digits % p);
+                digits /= p;
+            }
+            
+            for(uint64_t index=first; index<last; index++){
+                // A zero constant term leaves x as a factor
+                if((n == 1 || f[0] != 0) && accepts(p, f, primitive, q, orderFactors)) found[piece].push_back(f);
+                for(int i=0; i<n && ++f[i] == (uint32_t) p; i++) f[i] = 0;
+            }
+        }
+    });
+    
+    vector<Polynomial> polynomials;
+    for(size_t piece=0; piece<pieces; piece++){
+        for(size_t i=0; i<found[piece].size(); i++) polynomials.push_back(toPolynomial(p, found[piece][i]));
+    }
+    return polynomials;
+}
+
+// Every monic irreducible polynomial of degree n over GF(p), in order of toInt(), using threads threads
+vector<Polynomial> irreduciblePolynomials(int p, int n, int threads){
+    return enumerate(p, n, threads, false);
+}
+
+// Every monic primitive polynomial of degree n over GF(p), in order of toInt(), using threads threads
+vector<Polynomial> primitivePolynomials(int p, int n, int threads){
+    return enumerate(p, n, threads, true);
+}
+
+// An irreducible (or primitive) monic polynomial of degree n with few terms
+Polynomial sparseIrreducible(int p, int n, bool primitive){
+    checkField(p, n);
+    uint64_t q = primitive ? primitiveOrder(p, n) : 0;
+    vector<uint64_t> orderFactors = primitive ? primeFactors(q - 1) : vector<uint64_t>();
+    vector<uint32_t> f(n + 1, 0);
+    f[n] = 1;
+    
+    if(p == 2 && n > 1){
+        f[0] = 1;
+        for(int k=1; k<n; k++){
+            f[k] = 1;
+            if(accepts(p, f, primitive, q, orderFactors)) return toPolynomial(p, f);
+            f[k] = 0;
+        }
+        for(int a=3; a<n; a++){
+            for(int b=2; b<a; b++){
+                for(int c=1; c<b; c++){
+                    f[a] = f[b] = f[c] = 1;
+                    if(accepts(p, f, primitive, q, orderFactors)) return toPolynomial(p, f);
+                    f[a] = f[b] = f[c] = 0;
+                }
+            }
+        }
+        throw runtime_error("No irreducible trinomial or pentanomial of degree " + to_string(n) + ".");
+    }
+    
+    // Lower coefficients count up as base p digits until one passes
+    while(true){
+        if(n == 1 || f[0] != 0){
+            if(accepts(p, f, primitive, q, orderFactors)) return toPolynomial(p, f);
+        }
+        int i = 0;
+        while(i < n && ++f[i] == (uint32_t) p) f[i++] = 0;
+        if(i == n) throw runtime_error("No polynomial of degree " + to_string(n) + " found.");
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * irreducible.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Irreducibility and primitivity of polynomials over GF(p), for
+ * checking a modulus before GaloisPolynomial::globalSetModulus
+ * or finding one. Both tests power x by p modulo f and take GCDs:
+ * Rabin's test proves irreducibility with one GCD per prime
+ * factor of the degree, Ben-Or's stops at the first small factor
+ * and so rejects random candidates quickly.
+ * 
+ * Both are built on Polynomial powMod and gcd. Its moduli are
+ * kept per thread, so the enumerators split candidates across
+ * threads, each candidate tested inside the thread's arena.
+ */
+
+#ifndef IRREDUCIBLE_H
+#define IRREDUCIBLE_H
+
+#include "galois_field.h"
+#include <cstdint>
+#include <vector>
+
+using std::uint64_t;
+using std::vector;
+
+// Largest prime the tests accept, so products of Modular<int> coefficients fit in an int
+const int IRREDUCIBLE_MAX_PRIME = 46337;
+// Most candidates an enumerator will test, p^n
+const uint64_t IRREDUCIBLE_MAX_CANDIDATES = (uint64_t) 1 << 32;
+
+// Whether f, of degree at least 1, is irreducible over GF(p), by Rabin's test
+bool isIrreducible(const Polynomial & f);
+// Whether f is irreducible over GF(p), by Ben-Or's test
+bool isIrreducibleBenOr(const Polynomial & f);
+// Whether f is primitive, irreducible with x generating every nonzero element. Needs p^n - 1 below 2^64
+bool isPrimitive(const Polynomial & f);
+
+// Number of monic irreducible polynomials of degree n over GF(p), by Gauss's formula
+uint64_t countIrreducible(int p, int n);
+// Number of monic primitive polynomials of degree n over GF(p), phi(p^n - 1) / n
+uint64_t countPrimitive(int p, int n);
+
+// Every monic irreducible polynomial of degree n over GF(p), in order of toInt(), using threads threads
+vector<Polynomial> irreduciblePolynomials(int p, int n, int threads = 0);
+// Every monic primitive polynomial of degree n over GF(p), in order of toInt(), using threads threads
+vector<Polynomial> primitivePolynomials(int p, int n, int threads = 0);
+
+// An irreducible (or primitive) monic polynomial of degree n with few terms: over GF(2) the trinomial
+// x^n + x^k + 1 with least k, else the pentanomial with least middle terms; otherwise the least by toInt()
+Polynomial sparseIrreducible(int p, int n, bool primitive = false);
+
+#endif
@@ -15,6 +15,7 @@
 // Parameter constructor with initial value
 template<typename T>
 QSMatrix<T>::QSMatrix(int rows, int cols, const T& _initial) {
+    INSTRUMENT_COUNT(matricesBuilt);
     _mat.resize(rows);
     for (int i=0; i<_mat.size(); i++) {
         _mat[i].resize(cols, _initial);
@@ -26,6 +27,7 @@ QSMatrix<T>::QSMatrix(int rows, int cols, const T& _initial) {
 // Parameter constructor with initial vector
 template<typename T>
 QSMatrix<T>::QSMatrix(int rows, int cols, const vector<T> & _initial) {
+    INSTRUMENT_COUNT(matricesBuilt);
     _mat.resize(rows);
     for (int i=0; i<_mat.size(); i++) {
         _mat[i].resize(cols);
@@ -40,6 +42,7 @@ QSMatrix<T>::QSMatrix(int rows, int cols, const vector<T> & _initial) {
 // Copy constructor
 template<typename T>
 QSMatrix<T>::QSMatrix(const QSMatrix<T>& rhs) {
+    INSTRUMENT_COUNT(matricesBuilt);
     _mat = rhs._mat;
     _rows = rhs.getRows();
     _cols = rhs.getCols();
@@ -137,15 +140,19 @@ QSMatrix<T>& QSMatrix<T>::operator-=(const QSMatrix<T>& rhs) {
 // Multiply two matrices
 template<typename T>
 QSMatrix<T> QSMatrix<T>::operator*(const QSMatrix<T>& rhs) const {
+    INSTRUMENT_COUNT(matrixMultiplies);
     int _rows = rhs.getRows();
     int _cols = rhs.getCols();
     QSMatrix result(_rows, _cols, 0.0);
 
+    // Each entry is reduced once after summing its products
     for (int i=0; i<_rows; i++) {
         for (int j=0; j<_cols; j++) {
+            ProductSum<T> sum;
             for (int k=0; k<_rows; k++) {
-                result(i,j) += this->_mat[i][k] * rhs(k,j);
+                sum.add(this->_mat[i][k], rhs(k,j));
             }
+            result(i,j) = sum.result();
         }
     }
 
@@ -233,12 +240,14 @@ QSMatrix<T> QSMatrix<T>::operator/(const T& rhs) const {
 // Multiply vector
 template<typename T>
 std::vector<T> QSMatrix<T>::operator*(const std::vector<T>& rhs) const {
-    std::vector<T> result(rhs.size(), 0.0);
+    std::vector<T> result(_rows, 0.0);
 
     for (int i=0; i<_rows; i++) {
+        ProductSum<T> sum;
         for (int j=0; j<_cols; j++) {
-            result[i] = this->_mat[i][j] * rhs[j];
+            sum.add(this->_mat[i][j], rhs[j]);
         }
+        result[i] = sum.result();
     }
 
     return result;
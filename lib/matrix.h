@@ -10,6 +10,9 @@
 #ifndef QS_MATRIX_H
 #define QS_MATRIX_H
 
+#include "arena.h"
+#include "instrument.h"
+#include "product_sum.h"
 #include <vector>
 #include <ostream>
 
@@ -18,7 +21,9 @@ using std::ostream;
 
 template <typename T> class QSMatrix {
 private:
-    vector<vector<T> > _mat;
+    // Rows of entries, taken from the thread's arena inside an ArenaScope
+    typedef vector<T, ArenaAllocator<T> > Row;
+    vector<Row, ArenaAllocator<Row> > _mat;
     int _rows;
     int _cols;
 
@@ -12,17 +12,30 @@
 #include "modular_arithmetic.h"
 
 template<typename T>
-T Modular<T>::_modulus;
+thread_local T Modular<T>::_modulus;
  
 template<typename T>
 Modular<T>::Modular(const T& value) : _val(value) { };
 
-// Sets the modulus
+// Sets the modulus for the calling thread, each thread keeps its own
 template<typename T>
 void Modular<T>::globalSetModulus(const T& modulus) {
+    INSTRUMENT_COUNT(modularModulusWrites);
     _modulus = modulus;
 }
 
+// The calling thread's modulus
+template<typename T>
+T Modular<T>::globalModulus() {
+    return _modulus;
+}
+
+// Wraps value after reducing it mod the modulus
+template<typename T>
+Modular<T> Modular<T>::reduced(const T& value) {
+    return Modular<T>(value % _modulus);
+}
+
 template<typename T>
 Modular<T> Modular<T>::addInverse() const{
     return Modular<T>(_modulus-_val);
@@ -31,6 +44,7 @@ Modular<T> Modular<T>::addInverse() const{
 // Finds multiplicative inverse via extended euclidean algorithm
 template<typename T>
 Modular<T> Modular<T>::mulInverse() const{
+    INSTRUMENT_COUNT(modularInverses);
     T t = 0;
     T r = _modulus;
     T new_t = 1;
@@ -58,6 +72,7 @@ Modular<T>& Modular<T>::operator=(const Modular<T>& other) {
 
 template<typename T>
 Modular<T>& Modular<T>::operator+=(const Modular<T>& other) {
+    INSTRUMENT_COUNT(modularOps);
     _val += other._val;
     _val %= _modulus;
     return *this;
@@ -65,6 +80,7 @@ Modular<T>& Modular<T>::operator+=(const Modular<T>& other) {
 
 template<typename T>
 Modular<T>& Modular<T>::operator-=(const Modular<T>& other) {
+    INSTRUMENT_COUNT(modularOps);
     _val += _modulus - other._val;
     _val %= _modulus;
     return *this;
@@ -72,6 +88,7 @@ Modular<T>& Modular<T>::operator-=(const Modular<T>& other) {
 
 template<typename T>
 Modular<T>& Modular<T>::operator*=(const Modular<T>& other) {
+    INSTRUMENT_COUNT(modularOps);
     _val *= other._val; 
     _val %= _modulus;
     return *this;
@@ -79,6 +96,7 @@ Modular<T>& Modular<T>::operator*=(const Modular<T>& other) {
 
 template<typename T>
 Modular<T>& Modular<T>::operator/=(const Modular<T>& other) {
+    INSTRUMENT_COUNT(modularOps);
     _val *= other.mulInverse()._val;
     _val %= _modulus; return *this;
 }
@@ -86,21 +104,25 @@ Modular<T>& Modular<T>::operator/=(const Modular<T>& other) {
 // Non modifying arithmetic operations
 template<typename T>
 Modular<T> Modular<T>::operator+(const Modular<T>& b) const {
+    INSTRUMENT_COUNT(modularOps);
     return Modular<T>((this->_val + b._val) % _modulus);
 }
 
 template<typename T>
 Modular<T> Modular<T>::operator-(const Modular<T>& b) const {
+    INSTRUMENT_COUNT(modularOps);
     return Modular<T>((this->_val + (_modulus - b._val)) % _modulus);
 }
 
 template<typename T>
 Modular<T> Modular<T>::operator*(const Modular<T>& b) const {
+    INSTRUMENT_COUNT(modularOps);
     return Modular<T>((this->_val * b._val) % _modulus);
 }
 
 template<typename T>
 Modular<T> Modular<T>::operator/(const Modular<T>& b) const {
+    INSTRUMENT_COUNT(modularOps);
     return Modular<T>((this->_val * b.mulInverse()._val) % _modulus);
 }
 
@@ -9,14 +9,22 @@
 #ifndef MODULAR_ARITHMETIC_H
 #define MODULAR_ARITHMETIC_H
 
+#include "instrument.h"
+#include "product_sum.h"
+#include <limits>
+
 template<typename T> // `T` is an integer type
 class Modular 
 {
 public:
     Modular(const T& value);
 
-    // Sets the modulus
+    // Sets the modulus for the calling thread, each thread keeps its own
     static void globalSetModulus(const T& modulus);
+    // The calling thread's modulus
+    static T globalModulus();
+    // Wraps value after reducing it mod the modulus
+    static Modular<T> reduced(const T& value);
     
     Modular<T> addInverse() const;
 
@@ -47,8 +55,33 @@ public:
 
 private:
     T _val;
-    static T _modulus;
+    static thread_local T _modulus;
+
+};
 
+/*
+ * ProductSum for Modular
+ * Adds raw products and reduces once at the end, or early if the
+ * sum nears overflow. Assumes (modulus - 1)^2 fits in half of T.
+ */
+template<typename T>
+class ProductSum<Modular<T>>{
+public:
+    ProductSum(): _sum(0) {}
+    
+    // Adds a * b to the sum without reducing
+    void add(const Modular<T>& a, const Modular<T>& b){
+        _sum += a.value() * b.value();
+        if(_sum > std::numeric_limits<T>::max() / 2) _sum = Modular<T>::reduced(_sum).value();
+    }
+    
+    // The reduced sum
+    Modular<T> result() const{
+        return Modular<T>::reduced(_sum);
+    }
+    
+private:
+    T _sum;
 };
 
 #include "modular_arithmetic.cpp"   // Compile implementation since it is a template class
@@ -0,0 +1,75 @@
+/*
+ * parallel.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Splits a range of independent work items across threads.
+ */
+
+#ifndef PARALLEL_CPP
+#define PARALLEL_CPP
+
+#include "parallel.h"
+#include <thread>
+#include <vector>
+#include <exception>
+#include <mutex>
+
+using std::thread;
+using std::vector;
+using std::exception_ptr;
+using std::mutex;
+
+// Number of threads to use when the caller does not say
+int defaultThreadCount(){
+    unsigned int n = thread::hardware_concurrency();
+    return n == 0 ? 1 : (int) n;
+}
+
+// Calls body(begin, end) on contiguous pieces of [0, count) using up to threads threads
+void parallelFor(size_t count, int threads, const function<void(size_t, size_t)> & body){
+    if(count == 0) return;
+    if(threads <= 0) threads = defaultThreadCount();
+    if((size_t) threads > count) threads = (int) count;
+    
+    // Run inline when there is nothing to split
+    if(threads == 1){
+        body(0, count);
+        return;
+    }
+    
+    exception_ptr error;
+    mutex errorLock;
+    vector<thread> workers;
+    workers.reserve(threads - 1);
+    
+    // Piece t covers [count*t/threads, count*(t+1)/threads), the caller runs piece 0
+    for(int t=1; t<threads; t++){
+        size_t begin = count * t / threads;
+        size_t end = count * (t + 1) / threads;
+        workers.push_back(thread([&, begin, end](){
+            try{
+                body(begin, end);
+            }
+            catch(...){
+                std::lock_guard<mutex> lock(errorLock);
+                if(!error) error = std::current_exception();
+            }
+        }));
+    }
+    
+    try{
+        body(0, count / threads);
+    }
+    catch(...){
+        std::lock_guard<mutex> lock(errorLock);
+        if(!error) error = std::current_exception();
+    }
+    
+    for(size_t i=0; i<workers.size(); i++){
+        workers[i].join();
+    }
+    if(error) std::rethrow_exception(error);
+}
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * parallel.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Splits a range of independent work items across threads.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+using std::size_t;
+using std::function;
+
+// Number of threads to use when the caller does not say
+int defaultThreadCount();
+
+// Calls body(begin, end) on contiguous pieces of [0, count) using up to
+// threads threads (0 means defaultThreadCount()), returns when all are done.
+// The first exception thrown by any piece is rethrown to the caller.
+void parallelFor(size_t count, int threads, const function<void(size_t, size_t)> & body);
+
+#endif
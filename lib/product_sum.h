@@ -0,0 +1,38 @@
+/*
+ * product_sum.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Accumulator for sums of products, the inner loop of matrix
+ * products and other dot products. Field types specialize it
+ * to add products unreduced and reduce once at the end.
+ */
+
+#ifndef PRODUCT_SUM_H
+#define PRODUCT_SUM_H
+
+/*
+ * ProductSum
+ * Adds up a*b terms and returns the total. The general version
+ * just uses the type's own operators.
+ */
+template<typename T>
+class ProductSum{
+public:
+    ProductSum(): _sum(0) {}
+    
+    // Adds a * b to the sum
+    void add(const T & a, const T & b){
+        _sum += a * b;
+    }
+    
+    // The sum of every product added
+    T result() const{
+        return _sum;
+    }
+
+private:
+    T _sum;
+};
+
+#endif
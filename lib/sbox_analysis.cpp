@@ -0,0 +1,176 @@
+/*
+ * sbox_analysis.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Cryptanalytic measures of an n bit S-Box, with the linear
+ * table computed by fast Walsh-Hadamard transforms.
+ */
+
+#ifndef SBOX_ANALYSIS_CPP
+#define SBOX_ANALYSIS_CPP
+
+#include "sbox_analysis.h"
+#include "aes.h"
+#include "parallel.h"
+#include <cstdlib>
+
+// Input width of an S-Box, checking it maps 2^n values into 2^n
+static int sboxBits(const vector<uint32_t> & sbox){
+    int n = 0;
+    while(n <= SBOX_MAX_BITS && ((size_t) 1 << n) < sbox.size()) n++;
+    if(n < 1 || n > SBOX_MAX_BITS || ((size_t) 1 << n) != sbox.size()){
+        throw runtime_error("S-Box must have 2^n entries for n from 1 to " + to_string(SBOX_MAX_BITS) + ".");
+    }
+    for(size_t x=0; x<sbox.size(); x++){
+        if(sbox[x] >= sbox.size()) throw runtime_error("S-Box output is wider than its input.");
+    }
+    return n;
+}
+
+// In place fast Walsh-Hadamard transform, butterflies of doubling span
+static void walshHadamard(vector<int32_t> & f){
+    for(size_t h=1; h<f.size(); h<<=1){
+        for(size_t i=0; i<f.size(); i+=2*h){
+            for(size_t j=i; j<i+h; j++){
+                int32_t a = f[j], b = f[j+h];
+                f[j] = a + b;
+                f[j+h] = a - b;
+            }
+        }
+    }
+}
+
+// S-Box x -> A * x^(-1) + b in GF(2^n) for the given modulus, A as n rows of n bits and b as a number.
+// Leaves the GaloisPolynomial modulus set to modulus
+vector<uint32_t> makeSBox(const Polynomial & modulus, const vector<Modular<int>> & A, uint32_t b){
+    int n = modulus.size() - 1;
+    if(modulus.getPrime() != 2 || n < 1 || n > SBOX_MAX_BITS) throw runtime_error("S-Box field must be GF(2^n) for small n.");
+    if((int) A.size() != n*n) throw runtime_error("Affine map must be n by n.");
+    
+    GaloisPolynomial::globalSetModulus(modulus);
+    Modular<int>::globalSetModulus(2);
+    GaloisPolynomial constant(b, 2, n);
+    vector<uint32_t> sbox((size_t) 1 << n);
+    for(size_t x=0; x<sbox.size(); x++){
+        GaloisPolynomial p(x, 2, n);
+        sbox[x] = sBox(p, A, constant).toInt();
+    }
+    return sbox;
+}
+
+// Difference table, entry [a << n | b] counts x with S(x) ^ S(x ^ a) = b
+vector<int32_t> differenceTable(const vector<uint32_t> & sbox, int threads){
+    int n = sboxBits(sbox);
+    size_t size = sbox.size();
+    vector<int32_t> table(size*size, 0);
+    parallelFor(size, threads, [&](size_t begin, size_t end){
+        for(size_t a=begin; a<end; a++){
+            int32_t * row = &table[a << n];
+            for(size_t x=0; x<size; x++){
+                row[sbox[x] ^ sbox[x ^ a]]++;
+            }
+        }
+    });
+    return table;
+}
+
+// Linear table of Walsh coefficients, entry [a << n | b] is the sum over x of (-1)^(a.x ^ b.S(x))
+vector<int32_t> linearTable(const vector<uint32_t> & sbox, int threads){
+    int n = sboxBits(sbox);
+    size_t size = sbox.size();
+    vector<int32_t> table(size*size);
+    
+    // Column b is the transform of the component function x -> b.S(x)
+    parallelFor(size, threads, [&](size_t begin, size_t end){
+        vector<int32_t> f(size);
+        for(size_t b=begin; b<end; b++){
+            for(size_t x=0; x<size; x++){
+                f[x] = __builtin_parity(b & sbox[x]) ? -1 : 1;
+            }
+            walshHadamard(f);
+            for(size_t a=0; a<size; a++){
+                table[a << n | b] = f[a];
+            }
+        }
+    });
+    return table;
+}
+
+// Linear table by summing every entry directly, for checking the transform
+vector<int32_t> linearTableDirect(const vector<uint32_t> & sbox){
+    int n = sboxBits(sbox);
+    size_t size = sbox.size();
+    vector<int32_t> table(size*size);
+    for(size_t a=0; a<size; a++){
+        for(size_t b=0; b<size; b++){
+            int32_t sum = 0;
+            for(size_t x=0; x<size; x++){
+                sum += __builtin_parity((a & x) ^ (b & sbox[x])) ? -1 : 1;
+            }
+            table[a << n | b] = sum;
+        }
+    }
+    return table;
+}
+
+// Highest degree of a monomial in the algebraic normal form of any output bit
+int algebraicDegree(const vector<uint32_t> & sbox){
+    sboxBits(sbox);
+    
+    // The Moebius transform works on every output bit at once, one per bit of the word
+    vector<uint32_t> anf = sbox;
+    for(size_t h=1; h<anf.size(); h<<=1){
+        for(size_t u=0; u<anf.size(); u++){
+            if(u & h) anf[u] ^= anf[u ^ h];
+        }
+    }
+    int degree = 0;
+    for(size_t u=0; u<anf.size(); u++){
+        if(anf[u] != 0) degree = max(degree, __builtin_popcount(u));
+    }
+    return degree;
+}
+
+// Every measure of one S-Box, using threads threads (0 for every core)
+SBoxProfile analyzeSBox(const vector<uint32_t> & sbox, int threads){
+    SBoxProfile profile = {};
+    int n = sboxBits(sbox);
+    size_t size = sbox.size();
+    profile.bits = n;
+    
+    vector<bool> seen(size, false);
+    profile.bijective = true;
+    for(size_t x=0; x<size; x++){
+        if(seen[sbox[x]]) profile.bijective = false;
+        seen[sbox[x]] = true;
+        if(sbox[x] == x) profile.fixedPoints++;
+    }
+    
+    vector<int32_t> ddt = differenceTable(sbox, threads);
+    for(size_t i=size; i<ddt.size(); i++){
+        profile.differentialUniformity = max(profile.differentialUniformity, ddt[i]);
+    }
+    
+    // Column 0 is the zero output mask, always 2^n at a = 0
+    vector<int32_t> lat = linearTable(sbox, threads);
+    for(size_t i=0; i<lat.size(); i++){
+        if((i & (size - 1)) != 0) profile.linearity = max(profile.linearity, std::abs(lat[i]));
+    }
+    profile.nonlinearity = (int) (size/2) - profile.linearity/2;
+    profile.algebraicDegree = algebraicDegree(sbox);
+    return profile;
+}
+
+// Profiles of many S-Boxes, one per thread at a time, for screening candidates
+vector<SBoxProfile> analyzeSBoxes(const vector<vector<uint32_t>> & sboxes, int threads){
+    vector<SBoxProfile> profiles(sboxes.size());
+    parallelFor(sboxes.size(), threads, [&](size_t begin, size_t end){
+        for(size_t i=begin; i<end; i++){
+            profiles[i] = analyzeSBox(sboxes[i], 1);
+        }
+    });
+    return profiles;
+}
+
+#endif
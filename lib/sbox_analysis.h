@@ -0,0 +1,65 @@
+/*
+ * sbox_analysis.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Cryptanalytic measures of an n bit S-Box: the difference
+ * distribution table, the linear approximation table, and from
+ * them differential uniformity, nonlinearity, algebraic degree
+ * and fixed points. These are the numbers behind the choice of
+ * inversion in GF(2^8) for the AES S-Box.
+ * 
+ * The linear table comes from one fast Walsh-Hadamard transform
+ * per output mask, O(n 2^2n) instead of O(2^3n) by brute force.
+ * Output masks, input differences and whole batches of S-Boxes
+ * are split across threads.
+ */
+
+#ifndef SBOX_ANALYSIS_H
+#define SBOX_ANALYSIS_H
+
+#include "galois_field.h"
+#include <cstdint>
+#include <vector>
+
+using std::int32_t;
+using std::uint32_t;
+using std::vector;
+
+// Widest S-Box analysed, its tables have 2^(2n) entries
+const int SBOX_MAX_BITS = 12;
+
+/*
+ * SBoxProfile
+ * Summary of an S-Box. Smaller uniformity and linearity, and
+ * larger nonlinearity and degree, mean stronger resistance.
+ */
+struct SBoxProfile{
+    int bits;
+    bool bijective;
+    int differentialUniformity;     // Largest difference table entry for a nonzero input difference
+    int linearity;                  // Largest |Walsh coefficient| for a nonzero output mask
+    int nonlinearity;               // 2^(n-1) - linearity/2, distance to the nearest affine function
+    int algebraicDegree;            // Largest degree of a coordinate function's algebraic normal form
+    int fixedPoints;                // x with S(x) = x
+};
+
+// S-Box x -> A * x^(-1) + b in GF(2^n) for the given modulus, A as n rows of n bits and b as a number.
+// Leaves the GaloisPolynomial modulus set to modulus
+vector<uint32_t> makeSBox(const Polynomial & modulus, const vector<Modular<int>> & A, uint32_t b);
+
+// Difference table, entry [a << n | b] counts x with S(x) ^ S(x ^ a) = b
+vector<int32_t> differenceTable(const vector<uint32_t> & sbox, int threads = 0);
+// Linear table of Walsh coefficients, entry [a << n | b] is the sum over x of (-1)^(a.x ^ b.S(x))
+vector<int32_t> linearTable(const vector<uint32_t> & sbox, int threads = 0);
+// Linear table by summing every entry directly, for checking the transform
+vector<int32_t> linearTableDirect(const vector<uint32_t> & sbox);
+// Highest degree of a monomial in the algebraic normal form of any output bit
+int algebraicDegree(const vector<uint32_t> & sbox);
+
+// Every measure of one S-Box, using threads threads (0 for every core)
+SBoxProfile analyzeSBox(const vector<uint32_t> & sbox, int threads = 0);
+// Profiles of many S-Boxes, one per thread at a time, for screening candidates
+vector<SBoxProfile> analyzeSBoxes(const vector<vector<uint32_t>> & sboxes, int threads = 0);
+
+#endif
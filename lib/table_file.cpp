@@ -0,0 +1,237 @@
+/*
+ * table_file.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Versioned, checksummed binary file of precomputed tables and
+ * expanded keys. Files are mapped read only, so every process
+ * using one shares the same pages and skips building them.
+ */
+
+#ifndef TABLE_FILE_CPP
+#define TABLE_FILE_CPP
+
+#include "table_file.h"
+#include "byte_order.h"
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Keys are stored as their object bytes and used in place
+static_assert(std::is_trivially_copyable<AesKey>::value, "AesKey must be trivially copyable to be mapped");
+static_assert(std::is_trivially_copyable<AesTables>::value, "AesTables must be trivially copyable to be mapped");
+
+// First bytes of every table file
+static const char tableFileMagic[8] = { 'A', 'E', 'S', 'T', 'A', 'B', 'L', 'E' };
+// Written in native order, reads back differently on a machine of the other byte order
+static const uint32_t byteOrderMark = 0x01020304;
+// Every section starts on a cache line
+static const size_t sectionAlignment = 64;
+
+/*
+ * TableFileHeader
+ * The first 64 bytes of the file. The checksum covers the header,
+ * with the checksum itself as zero, and the directory.
+ */
+struct TableFileHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t fileSize;
+    uint64_t sectionCount;
+    uint64_t checksum;
+    unsigned char reserved[24];
+};
+
+static_assert(sizeof(TableFileHeader) == 64, "Table file header must be 64 bytes");
+static_assert(sizeof(TableSectionEntry) == 40, "Table file directory entries must be 40 bytes");
+
+// Word at a time FNV-1a, enough to catch truncated or damaged files
+static uint64_t checksum(const unsigned char * p, size_t length, uint64_t h = 0xcbf29ce484222325ULL){
+    const uint64_t prime = 0x100000001b3ULL;
+    size_t i = 0;
+    for(; i+8<=length; i+=8){
+        h = (h ^ loadLittle64(p + i)) * prime;
+    }
+    for(; i<length; i++){
+        h = (h ^ p[i]) * prime;
+    }
+    return h;
+}
+
+// Rounds up to a multiple of the section alignment
+static size_t alignSection(size_t n){
+    return (n + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+}
+
+// Adds the AES lookup tables with the field modulus they were built for
+void TableFileWriter::addAesTables(const AesTables & tables, uint32_t modulus){
+    addSection(SECTION_AES_TABLES, sizeof(AesTables), modulus,
+               ConstByteSpan((const unsigned char *) &tables, sizeof(AesTables)));
+}
+
+// Adds expanded keys, which a reader uses in place
+void TableFileWriter::addKeys(const AesKey * keys, size_t count){
+    addSection(SECTION_AES_KEYS, sizeof(AesKey), 0,
+               ConstByteSpan((const unsigned char *) keys, count*sizeof(AesKey)));
+}
+
+// Adds a section of any kind, copying its bytes
+void TableFileWriter::addSection(uint32_t kind, uint32_t itemSize, uint32_t parameter, ConstByteSpan data){
+    if(itemSize == 0 || data.size % itemSize != 0) throw runtime_error("Section must hold whole items.");
+    Pending p;
+    p.entry = TableSectionEntry{ kind, itemSize, parameter, 0, 0, data.size, checksum(data.data, data.size) };
+    p.data.assign(data.data, data.data + data.size);
+    _sections.push_back(std::move(p));
+}
+
+// Writes the file beside path and renames it over, so processes mapping an old file keep valid pages
+void TableFileWriter::write(const string & path) const{
+    size_t offset = alignSection(sizeof(TableFileHeader) + _sections.size()*sizeof(TableSectionEntry));
+    vector<TableSectionEntry> entries;
+    for(size_t i=0; i<_sections.size(); i++){
+        TableSectionEntry e = _sections[i].entry;
+        e.offset = offset;
+        entries.push_back(e);
+        offset = alignSection(offset + e.length);
+    }
+    
+    vector<unsigned char> file(offset, 0);
+    TableFileHeader header = {};
+    memcpy(header.magic, tableFileMagic, sizeof(header.magic));
+    header.version = TABLE_FILE_VERSION;
+    header.byteOrder = byteOrderMark;
+    header.fileSize = file.size();
+    header.sectionCount = entries.size();
+    memcpy(file.data(), &header, sizeof(header));
+    memcpy(file.data() + sizeof(header), entries.data(), entries.size()*sizeof(TableSectionEntry));
+    header.checksum = checksum(file.data(), sizeof(header) + entries.size()*sizeof(TableSectionEntry));
+    memcpy(file.data(), &header, sizeof(header));
+    for(size_t i=0; i<_sections.size(); i++){
+        memcpy(file.data() + entries[i].offset, _sections[i].data.data(), _sections[i].data.size());
+    }
+    
+    string temporary = path + ".tmp";
+    FILE * f = fopen(temporary.c_str(), "wb");
+    if(f == nullptr) throw runtime_error("Cannot create " + temporary);
+    bool written = fwrite(file.data(), 1, file.size(), f) == file.size();
+    written = fclose(f) == 0 && written;
+    if(!written || rename(temporary.c_str(), path.c_str()) != 0){
+        remove(temporary.c_str());
+        throw runtime_error("Cannot write " + path);
+    }
+}
+
+TableFile::TableFile(const string & path, bool verify): _data(nullptr), _size(0), _entries(nullptr), _sectionCount(0), _keys(-1) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) throw runtime_error("Cannot open " + path);
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(TableFileHeader)){
+        close(fd);
+        throw runtime_error("Table file is too short: " + path);
+    }
+    _size = st.st_size;
+    void * p = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED) throw runtime_error("Cannot map " + path);
+    _data = (const unsigned char *) p;
+    
+    // Everything below throws through here so the mapping is not leaked
+    try{
+        TableFileHeader header;
+        memcpy(&header, _data, sizeof(header));
+        if(memcmp(header.magic, tableFileMagic, sizeof(header.magic)) != 0) throw runtime_error("Not a table file: " + path);
+        if(header.version != TABLE_FILE_VERSION) throw runtime_error("Unsupported table file version: " + path);
+        if(header.byteOrder != byteOrderMark) throw runtime_error("Table file has the wrong byte order: " + path);
+        if(header.fileSize != _size) throw runtime_error("Table file is truncated: " + path);
+        size_t directoryEnd = sizeof(header) + header.sectionCount*sizeof(TableSectionEntry);
+        if(header.sectionCount > _size / sizeof(TableSectionEntry) || directoryEnd > _size){
+            throw runtime_error("Table file directory is damaged: " + path);
+        }
+        
+        uint64_t expected = header.checksum;
+        header.checksum = 0;
+        uint64_t sum = checksum((const unsigned char *) &header, sizeof(header));
+        sum = checksum(_data + sizeof(header), directoryEnd - sizeof(header), sum);
+        if(sum != expected) throw runtime_error("Table file header checksum mismatch: " + path);
+        
+        _entries = (const TableSectionEntry *) (_data + sizeof(header));
+        _sectionCount = header.sectionCount;
+        for(size_t i=0; i<_sectionCount; i++){
+            const TableSectionEntry & e = _entries[i];
+            if(e.offset % sectionAlignment != 0 || e.offset > _size || e.length > _size - e.offset){
+                throw runtime_error("Table file section out of range: " + path);
+            }
+            if(verify && checksum(_data + e.offset, e.length) != e.checksum){
+                throw runtime_error("Table file section checksum mismatch: " + path);
+            }
+        }
+        
+        // Stored structures must match this build's before they are used in place
+        long tables = find(SECTION_AES_TABLES);
+        if(tables >= 0 && (_entries[tables].itemSize != sizeof(AesTables) || _entries[tables].length != sizeof(AesTables))){
+            throw runtime_error("Table file AES tables do not match this build: " + path);
+        }
+        _keys = find(SECTION_AES_KEYS);
+        if(_keys >= 0 && _entries[_keys].itemSize != sizeof(AesKey)){
+            throw runtime_error("Table file keys do not match this build: " + path);
+        }
+    }
+    catch(...){
+        munmap((void *) _data, _size);
+        throw;
+    }
+}
+
+TableFile::~TableFile(){
+    munmap((void *) _data, _size);
+}
+
+// Number of sections in the directory
+size_t TableFile::sectionCount() const{
+    return _sectionCount;
+}
+
+// Directory entry of section i
+const TableSectionEntry & TableFile::entry(size_t i) const{
+    if(i >= _sectionCount) throw runtime_error("Section out of range.");
+    return _entries[i];
+}
+
+// Bytes of section i
+ConstByteSpan TableFile::section(size_t i) const{
+    const TableSectionEntry & e = entry(i);
+    return ConstByteSpan(_data + e.offset, e.length);
+}
+
+// Index of the first section of a kind, or -1 if there is none
+long TableFile::find(uint32_t kind) const{
+    for(size_t i=0; i<_sectionCount; i++){
+        if(_entries[i].kind == kind) return i;
+    }
+    return -1;
+}
+
+// The AES lookup tables in the file, or nullptr if it has none
+const AesTables * TableFile::aesTables() const{
+    long i = find(SECTION_AES_TABLES);
+    if(i < 0 || _entries[i].parameter != 0x11b) return nullptr;
+    return (const AesTables *) (_data + _entries[i].offset);
+}
+
+// Number of expanded keys in the file
+size_t TableFile::keyCount() const{
+    return _keys < 0 ? 0 : _entries[_keys].length / sizeof(AesKey);
+}
+
+// Expanded key i, used straight from the mapping
+const AesKey & TableFile::key(size_t i) const{
+    if(i >= keyCount()) throw runtime_error("Key out of range.");
+    return ((const AesKey *) (_data + _entries[_keys].offset))[i];
+}
+
+#endif
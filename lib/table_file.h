@@ -0,0 +1,118 @@
+/*
+ * table_file.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Versioned, checksummed binary file of precomputed tables and
+ * expanded keys. Files are mapped read only, so every process
+ * using one shares the same pages and skips building them.
+ * 
+ * Layout: a 64 byte header, a directory of sections, then each
+ * section's bytes starting on a 64 byte boundary. Sections are
+ * stored as they sit in memory, so a file only loads on a
+ * machine with the writer's byte order and structure sizes.
+ */
+
+#ifndef TABLE_FILE_H
+#define TABLE_FILE_H
+
+#include "aes_key.h"
+#include "aes_tables.h"
+#include "byte_span.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using std::uint32_t;
+using std::uint64_t;
+using std::string;
+using std::vector;
+
+// Format version written, files with any other version are rejected
+const uint32_t TABLE_FILE_VERSION = 1;
+
+// Kinds of section a table file can hold
+enum TableSection{
+    SECTION_AES_TABLES = 1,     // One AesTables, parameter is the field modulus it was built for
+    SECTION_AES_KEYS = 2,       // Expanded AesKeys back to back
+    SECTION_FIELD_TABLES = 3    // Exp, log and inverse tables of a field, parameter is its order
+};
+
+/*
+ * TableSectionEntry
+ * Directory entry for one section. itemSize is the size of one
+ * stored object, checked against the reader's own structures.
+ */
+struct TableSectionEntry{
+    uint32_t kind;
+    uint32_t itemSize;
+    uint32_t parameter;
+    uint32_t reserved;
+    uint64_t offset;        // From the start of the file
+    uint64_t length;
+    uint64_t checksum;      // Of the section bytes
+};
+
+/*
+ * TableFileWriter
+ * Collects sections in memory and writes them as one file.
+ */
+class TableFileWriter{
+public:
+    // Adds the AES lookup tables with the field modulus they were built for
+    void addAesTables(const AesTables & tables, uint32_t modulus = 0x11b);
+    // Adds expanded keys, which a reader uses in place
+    void addKeys(const AesKey * keys, size_t count);
+    // Adds a section of any kind, copying its bytes
+    void addSection(uint32_t kind, uint32_t itemSize, uint32_t parameter, ConstByteSpan data);
+    
+    // Writes the file beside path and renames it over, so processes mapping an old file keep valid pages
+    void write(const string & path) const;
+
+private:
+    struct Pending{
+        TableSectionEntry entry;
+        vector<unsigned char> data;
+    };
+    vector<Pending> _sections;
+};
+
+/*
+ * TableFile
+ * A table file mapped read only. The header, directory and
+ * every section checksum are checked when it is opened, unless
+ * verification is turned off to touch only the pages used.
+ * Pointers it returns are valid while it is open.
+ */
+class TableFile{
+public:
+    explicit TableFile(const string & path, bool verify = true);
+    ~TableFile();
+    TableFile(const TableFile &) = delete;
+    TableFile & operator=(const TableFile &) = delete;
+    
+    // Number of sections in the directory
+    size_t sectionCount() const;
+    // Directory entry of section i
+    const TableSectionEntry & entry(size_t i) const;
+    // Bytes of section i
+    ConstByteSpan section(size_t i) const;
+    // Index of the first section of a kind, or -1 if there is none
+    long find(uint32_t kind) const;
+    
+    // The AES lookup tables in the file, or nullptr if it has none
+    const AesTables * aesTables() const;
+    // Number of expanded keys in the file
+    size_t keyCount() const;
+    // Expanded key i, used straight from the mapping
+    const AesKey & key(size_t i) const;
+
+private:
+    const unsigned char * _data;
+    size_t _size;
+    const TableSectionEntry * _entries;
+    size_t _sectionCount;
+    long _keys;
+};
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * thread_pool.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * A fixed set of worker threads with one task deque each.
+ * Workers take their own newest task first and steal the
+ * oldest task of another worker when they run dry.
+ */
+
+#ifndef THREAD_POOL_CPP
+#define THREAD_POOL_CPP
+
+#include "thread_pool.h"
+#include "parallel.h"
+
+// Pool and worker index of the calling thread, null outside any pool
+static thread_local const ThreadPool * currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+ThreadPool::ThreadPool(int threads): _queued(0), _nextWorker(0), _stopping(false) {
+    if(threads <= 0) threads = defaultThreadCount();
+    for(int i=0; i<threads; i++){
+        _workers.push_back(unique_ptr<Worker>(new Worker()));
+    }
+    for(int i=0; i<threads; i++){
+        _threads.push_back(std::thread([this, i](){ run(i); }));
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for(size_t i=0; i<_threads.size(); i++){
+        _threads[i].join();
+    }
+}
+
+// Queues a task to run on some worker
+void ThreadPool::submit(function<void()> task){
+    size_t index = currentPool == this ? currentWorker : _nextWorker++ % _workers.size();
+    {
+        std::lock_guard<std::mutex> lock(_workers[index]->lock);
+        _workers[index]->tasks.push_back(std::move(task));
+    }
+    
+    // Count the task only once it is queued, so a worker that claims it always finds one
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _queued++;
+    }
+    _wake.notify_one();
+}
+
+// Number of worker threads
+int ThreadPool::threadCount() const{
+    return (int) _threads.size();
+}
+
+// Takes a task from the back of worker index, or steals one from the front of another
+bool ThreadPool::take(int index, function<void()> & task){
+    size_t n = _workers.size();
+    for(size_t k=0; k<n; k++){
+        Worker & w = *_workers[(index + k) % n];
+        std::lock_guard<std::mutex> lock(w.lock);
+        if(w.tasks.empty()) continue;
+        if(k == 0){
+            task = std::move(w.tasks.back());
+            w.tasks.pop_back();
+        }
+        else{
+            task = std::move(w.tasks.front());
+            w.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+// Worker loop for worker index
+void ThreadPool::run(int index){
+    currentPool = this;
+    currentWorker = index;
+    
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(_sleepLock);
+            _wake.wait(lock, [this]{ return _queued > 0 || _stopping; });
+            if(_queued == 0) return;
+            _queued--;
+        }
+        
+        // Every claimed task is on some deque, but a scan can miss it while
+        // other workers take and submit around it, so scan until it turns up
+        function<void()> task;
+        while(!take(index, task)){
+            std::this_thread::yield();
+        }
+        task();
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * thread_pool.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * A fixed set of worker threads with one task deque each.
+ * Workers take their own newest task first and steal the
+ * oldest task of another worker when they run dry.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::size_t;
+using std::function;
+using std::unique_ptr;
+using std::vector;
+
+/*
+ * ThreadPool
+ * Tasks submitted from a worker go on that worker's deque, so
+ * work a task spawns stays on the same core unless another
+ * worker is idle. Tasks from other threads are dealt round
+ * robin. Tasks must not throw. The destructor runs every queued
+ * task before joining the workers.
+ */
+class ThreadPool{
+public:
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+    
+    // Queues a task to run on some worker
+    void submit(function<void()> task);
+    // Number of worker threads
+    int threadCount() const;
+    
+private:
+    struct Worker{
+        std::mutex lock;
+        std::deque<function<void()>> tasks;
+    };
+    
+    // Worker loop for worker index
+    void run(int index);
+    // Takes a task from the back of worker index, or steals one from the front of another
+    bool take(int index, function<void()> & task);
+    
+    vector<unique_ptr<Worker>> _workers;
+    vector<std::thread> _threads;
+    std::mutex _sleepLock;
+    std::condition_variable _wake;
+    size_t _queued;         // Tasks submitted and not yet taken, guarded by _sleepLock
+    std::atomic<size_t> _nextWorker;    // Round robin position for outside submissions
+    bool _stopping;
+};
+
+#endif
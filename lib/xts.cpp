@@ -0,0 +1,155 @@
+/*
+ * xts.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * XTS-AES (IEEE 1619) for sector based storage. Each block of
+ * a data unit is masked by the tweak T*a^j, where a is the
+ * element x of GF(2^128) mod x^128 + x^7 + x^2 + x + 1, so the
+ * tweak for the next block is one shift and a conditional add.
+ */
+
+#ifndef XTS_CPP
+#define XTS_CPP
+
+#include "xts.h"
+#include "parallel.h"
+#include "byte_order.h"
+#include <cstring>
+
+// Blocks masked and encrypted per engine call
+static const size_t XTS_CHUNK_BLOCKS = 32;
+
+// Multiply the tweak (lo, hi) by a: bytes are little endian, x^128 folds back as 0x87
+static inline void multiplyAlpha(uint64_t & lo, uint64_t & hi){
+    uint64_t carry = hi >> 63;
+    hi = (hi << 1) | (lo >> 63);
+    lo = (lo << 1) ^ (0x87 * carry);
+}
+
+// Multiply a tweak held in bytes by a
+static inline void multiplyAlpha(unsigned char * t){
+    uint64_t lo = loadLittle64(t);
+    uint64_t hi = loadLittle64(t + 8);
+    multiplyAlpha(lo, hi);
+    storeLittle64(t, lo);
+    storeLittle64(t + 8, hi);
+}
+
+Xts::Xts(const AesKey & dataKey, const AesKey & tweakKey, AesEngine engine):
+    _dataKey(dataKey), _tweakKey(tweakKey), _engine(resolveEngine(engine)){
+    if(dataKey.rounds() != tweakKey.rounds()) throw runtime_error("XTS keys must have the same rounds.");
+    // IEEE 1619 and SP 800-38E require two different keys, equal schedules mean equal keys
+    if(memcmp(dataKey.encryptionKeys(), tweakKey.encryptionKeys(), AES_BLOCK_SIZE*(dataKey.rounds()+1)) == 0)
+        throw runtime_error("XTS data and tweak keys must differ.");
+}
+
+// Masks, encrypts or decrypts, and masks again consecutive blocks, advancing the tweak
+void Xts::cryptBlocks(bool encrypting, unsigned char * t, const unsigned char * in,
+                      unsigned char * out, size_t blocks) const{
+    unsigned char tweaks[16*XTS_CHUNK_BLOCKS];
+    unsigned char buffer[16*XTS_CHUNK_BLOCKS];
+    uint64_t lo = loadLittle64(t);
+    uint64_t hi = loadLittle64(t + 8);
+    
+    while(blocks > 0){
+        size_t n = blocks < XTS_CHUNK_BLOCKS ? blocks : XTS_CHUNK_BLOCKS;
+        
+        // Lay out the tweaks for the chunk so the engine sees whole runs of blocks
+        for(size_t b=0; b<n; b++){
+            storeLittle64(tweaks + 16*b, lo);
+            storeLittle64(tweaks + 16*b + 8, hi);
+            multiplyAlpha(lo, hi);
+        }
+        xorBytes(buffer, in, tweaks, 16*n);
+        if(encrypting) encryptBlocks(_engine, _dataKey, buffer, buffer, n);
+        else decryptBlocks(_engine, _dataKey, buffer, buffer, n);
+        xorBytes(out, buffer, tweaks, 16*n);
+        
+        in += 16*n;
+        out += 16*n;
+        blocks -= n;
+    }
+    
+    storeLittle64(t, lo);
+    storeLittle64(t + 8, hi);
+}
+
+// Runs one data unit, stealing ciphertext when length is not a whole number of blocks
+void Xts::cryptUnit(bool encrypting, const unsigned char * tweak, const unsigned char * in,
+                    unsigned char * out, size_t length) const{
+    if(length < 16) throw runtime_error("XTS data unit must be at least 16 bytes.");
+    
+    unsigned char t[16];
+    encryptBlocks(_engine, _tweakKey, tweak, t, 1);
+    
+    size_t blocks = length / 16;
+    size_t partial = length % 16;
+    if(partial == 0){
+        cryptBlocks(encrypting, t, in, out, blocks);
+        return;
+    }
+    
+    // Every block but the last whole one runs normally
+    cryptBlocks(encrypting, t, in, out, blocks - 1);
+    in += 16*(blocks - 1);
+    out += 16*(blocks - 1);
+    
+    // Decryption undoes the two stolen blocks with their tweaks swapped
+    unsigned char tFirst[16], tSecond[16];
+    memcpy(tFirst, t, 16);
+    multiplyAlpha(t);
+    memcpy(tSecond, t, 16);
+    if(!encrypting){
+        memcpy(tSecond, tFirst, 16);
+        memcpy(tFirst, t, 16);
+    }
+    
+    // The last whole block is processed and its tail is borrowed by the partial block
+    unsigned char last[16];
+    cryptBlocks(encrypting, tFirst, in, last, 1);
+    unsigned char stolen[16];
+    memcpy(stolen, in + 16, partial);
+    memcpy(stolen + partial, last + partial, 16 - partial);
+    memcpy(out + 16, last, partial);
+    cryptBlocks(encrypting, tSecond, stolen, out, 1);
+}
+
+// Encrypts one data unit of at least 16 bytes under a 16 byte tweak value
+void Xts::encryptUnit(const unsigned char * tweak, const unsigned char * in, unsigned char * out, size_t length) const{
+    cryptUnit(true, tweak, in, out, length);
+}
+
+// Decrypts one data unit of at least 16 bytes under a 16 byte tweak value
+void Xts::decryptUnit(const unsigned char * tweak, const unsigned char * in, unsigned char * out, size_t length) const{
+    cryptUnit(false, tweak, in, out, length);
+}
+
+// Runs a range of sectors, the tweak value is the sector number in little endian
+void Xts::cryptSectors(bool encrypting, const unsigned char * in, unsigned char * out, size_t sectorSize,
+                       size_t sectorCount, uint64_t firstSector, int threads) const{
+    parallelFor(sectorCount, threads, [&](size_t begin, size_t end){
+        for(size_t s=begin; s<end; s++){
+            unsigned char tweak[16] = {0};
+            uint64_t sector = firstSector + s;
+            for(int i=0; i<8; i++){
+                tweak[i] = (unsigned char) (sector >> (8*i));
+            }
+            cryptUnit(encrypting, tweak, in + s*sectorSize, out + s*sectorSize, sectorSize);
+        }
+    });
+}
+
+// Encrypts sectorCount sectors of sectorSize bytes, numbered from firstSector
+void Xts::encryptSectors(const unsigned char * in, unsigned char * out, size_t sectorSize,
+                         size_t sectorCount, uint64_t firstSector, int threads) const{
+    cryptSectors(true, in, out, sectorSize, sectorCount, firstSector, threads);
+}
+
+// Decrypts sectorCount sectors of sectorSize bytes, numbered from firstSector
+void Xts::decryptSectors(const unsigned char * in, unsigned char * out, size_t sectorSize,
+                         size_t sectorCount, uint64_t firstSector, int threads) const{
+    cryptSectors(false, in, out, sectorSize, sectorCount, firstSector, threads);
+}
+
+#endif
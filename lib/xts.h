@@ -0,0 +1,59 @@
+/*
+ * xts.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * XTS-AES (IEEE 1619) for sector based storage. Each block of
+ * a data unit is masked by the tweak T*a^j, where a is the
+ * element x of GF(2^128) mod x^128 + x^7 + x^2 + x + 1, so the
+ * tweak for the next block is one shift and a conditional add.
+ */
+
+#ifndef XTS_H
+#define XTS_H
+
+#include "aes_key.h"
+#include <cstdint>
+
+using std::uint64_t;
+
+/*
+ * Xts
+ * Holds the expanded data key and tweak key, which must differ.
+ * Nothing is modified after construction, so sectors can be
+ * processed from many threads at once.
+ */
+class Xts{
+public:
+    Xts(const AesKey & dataKey, const AesKey & tweakKey, AesEngine engine = ENGINE_AUTO);
+    
+    // Encrypts sectorCount sectors of sectorSize bytes, numbered from firstSector,
+    // spread over threads threads (0 means one per core)
+    void encryptSectors(const unsigned char * in, unsigned char * out, size_t sectorSize,
+                        size_t sectorCount, uint64_t firstSector, int threads = 0) const;
+    // Decrypts sectorCount sectors of sectorSize bytes, numbered from firstSector
+    void decryptSectors(const unsigned char * in, unsigned char * out, size_t sectorSize,
+                        size_t sectorCount, uint64_t firstSector, int threads = 0) const;
+    
+    // Encrypts one data unit of at least 16 bytes under a 16 byte tweak value
+    void encryptUnit(const unsigned char * tweak, const unsigned char * in, unsigned char * out, size_t length) const;
+    // Decrypts one data unit of at least 16 bytes under a 16 byte tweak value
+    void decryptUnit(const unsigned char * tweak, const unsigned char * in, unsigned char * out, size_t length) const;
+    
+private:
+    // Runs one data unit, stealing ciphertext when length is not a whole number of blocks
+    void cryptUnit(bool encrypting, const unsigned char * tweak, const unsigned char * in,
+                   unsigned char * out, size_t length) const;
+    // Masks, encrypts or decrypts, and masks again consecutive blocks, advancing the tweak
+    void cryptBlocks(bool encrypting, unsigned char * t, const unsigned char * in,
+                     unsigned char * out, size_t blocks) const;
+    // Runs a range of sectors
+    void cryptSectors(bool encrypting, const unsigned char * in, unsigned char * out, size_t sectorSize,
+                      size_t sectorCount, uint64_t firstSector, int threads) const;
+    
+    AesKey _dataKey;
+    AesKey _tweakKey;
+    AesEngine _engine;
+};
+
+#endif
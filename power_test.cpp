@@ -0,0 +1,138 @@
+/*
+ * power_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing big exponents, sliding window powering of Polynomial
+ * and GaloisPolynomial, the characteristic 2 square, and the
+ * Frobenius matrices against powering directly.
+ */
+
+#include "lib/aes.h"
+#include "lib/frobenius.h"
+#include "lib/gcm.h"
+#include "lib/irreducible.h"
+#include "test_util.h"
+#include <iostream>
+#include <random>
+#include <string>
+
+using std::cout;
+using std::string;
+
+// Random polynomial of degree below n over GF(p)
+Polynomial randomPolynomial(std::mt19937 & rng, int p, int n){
+    vector<Modular<int>> c;
+    for(int i=0; i<n; i++) c.push_back((int) (rng() % p));
+    return Polynomial(c, p);
+}
+
+// Exponent arithmetic and decimal round trips
+bool testExponent(){
+    Exponent big = Exponent::fromString("340282366920938463463374607431768211456");
+    bool ok = big == Exponent::power(2, 128) && big.bitLength() == 129 && big.bit(128) && !big.bit(127);
+    big -= 1;
+    ok &= big.bitLength() == 128 && big.toString() == "340282366920938463463374607431768211455";
+    ok &= big.divide(255) == 0 && big.divide(65537) == 0;
+    Exponent small(1000);
+    small *= 1000;
+    small += 7;
+    ok &= small.toString() == "1000007" && Exponent().isZero() && Exponent().bitLength() == 0;
+    return ok;
+}
+
+// The characteristic 2 square matches the product, and odd primes still square correctly
+bool testSquare(){
+    std::mt19937 rng(47);
+    bool ok = true;
+    for(int trial=0; trial<20; trial++){
+        Polynomial a = randomPolynomial(rng, 2, 40), b = randomPolynomial(rng, 5, 12);
+        ok &= a.square().toString() == (a * a).toString() && b.square().toString() == (b * b).toString();
+    }
+    return ok;
+}
+
+// In GF(2^8) every nonzero a has a^255 = 1, and a^254 and Fermat are the inverse
+bool testSmallField(){
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    bool ok = true;
+    for(int v=1; v<256; v++){
+        GaloisPolynomial a(v);
+        int inverse = a.inverse().toInt();
+        ok &= a.pow(Exponent(255)).toInt() == 1 && a.pow(Exponent(254)).toInt() == inverse;
+        ok &= a.inverseByFermat().toInt() == inverse && a.pow(Exponent(0)).toInt() == 1;
+        ok &= a.pow(Exponent(3)).toInt() == (a * a * a).toInt();
+    }
+    return ok;
+}
+
+// Powers in GF(5^3) split as sums of exponents, checking the odd prime path
+bool testOddField(){
+    Polynomial mod5(vector<Modular<int>>{ 2, 3, 0, 1 }, 5);
+    std::mt19937 rng(48);
+    bool ok = true;
+    for(int trial=0; trial<20; trial++){
+        Polynomial a = randomPolynomial(rng, 5, 3);
+        if(a.size() == 0) continue;
+        uint64_t e = rng() % 1000, f = rng() % 1000;
+        Polynomial split = (a.powMod(Exponent(e), mod5) * a.powMod(Exponent(f), mod5)) % mod5;
+        ok &= split.toString() == a.powMod(Exponent(e + f), mod5).toString();
+        ok &= a.powMod(Exponent(124), mod5).toString() == "1";
+    }
+    return ok;
+}
+
+// In GF(2^128), a^(2^128 - 1) = 1 and a^(2^128) = a, with 128 bit exponents
+bool testLargeField(){
+    GaloisPolynomial::globalSetModulus(gcm_Mod);
+    std::mt19937 rng(49);
+    Exponent order = Exponent::power(2, 128);
+    bool ok = true;
+    for(int trial=0; trial<2; trial++){
+        GaloisPolynomial a(randomPolynomial(rng, 2, 128));
+        ok &= a.pow(order).toString() == a.toString();
+        order -= 1;
+        ok &= a.pow(order).toInt() == 1;
+        order += 1;
+        ok &= (a * a.inverseByFermat()).toInt() == 1;
+    }
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    return ok;
+}
+
+// Frobenius matrices match powering by p^k, compose by adding powers, and x^(p^n) = x for irreducible f
+bool testFrobenius(){
+    std::mt19937 rng(50);
+    bool ok = true;
+    Polynomial moduli[] = { rijndael_Mod, gcm_Mod, sparseIrreducible(3, 5) };
+    for(const Polynomial & f : moduli){
+        int p = f.getPrime(), n = f.size() - 1;
+        FrobeniusMap once(f), twice(f, 2), thrice = once * twice, whole(f, n);
+        for(int trial=0; trial<3; trial++){
+            Polynomial a = randomPolynomial(rng, p, n);
+            ok &= once.apply(a).toString() == a.powMod(Exponent(p), f).toString();
+            ok &= twice.apply(a).toString() == a.powMod(Exponent::power(p, 2), f).toString();
+            ok &= thrice.apply(a).toString() == (FrobeniusMap(f, 3)).apply(a).toString();
+            ok &= whole.apply(a).toString() == a.toString();
+        }
+        ok &= thrice.power() == 3 && whole.degree() == n && whole.prime() == p;
+    }
+    
+    GaloisPolynomial::globalSetModulus(rijndael_Mod);
+    GaloisPolynomial g(0x57);
+    ok &= FrobeniusMap(rijndael_Mod, 3).apply(g).toInt() == g.pow(Exponent(8)).toInt();
+    return ok;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("Big exponents", testExponent());
+    ok &= report("Squares", testSquare());
+    ok &= report("Powers in GF(2^8)", testSmallField());
+    ok &= report("Powers in GF(5^3)", testOddField());
+    ok &= report("Powers in GF(2^128)", testLargeField());
+    ok &= report("Frobenius matrices", testFrobenius());
+    
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+/*
+ * sbox_analysis_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing the S-Box measures on the AES S-Box, whose values are
+ * well known, on plain inversion and the identity, and the fast
+ * linear table against direct summation.
+ */
+
+#include "lib/aes.h"
+#include "lib/aes_tables.h"
+#include "lib/sbox_analysis.h"
+#include "test_util.h"
+#include <iostream>
+#include <random>
+#include <string>
+
+using std::cout;
+using std::string;
+
+// The AES S-Box has uniformity 4, nonlinearity 112, degree 7 and no fixed points
+bool testAes(){
+    vector<uint32_t> sbox = makeSBox(rijndael_Mod, rijndael_A, 0x63);
+    const AesTables & t = aesTables();
+    bool ok = true;
+    for(int x=0; x<256; x++) ok &= sbox[x] == t.sbox[x];
+    
+    SBoxProfile p = analyzeSBox(sbox, 4);
+    return ok && p.bits == 8 && p.bijective && p.differentialUniformity == 4 && p.linearity == 32
+        && p.nonlinearity == 112 && p.algebraicDegree == 7 && p.fixedPoints == 0;
+}
+
+// Inversion alone, an identity affine map, keeps the measures but fixes 0 and 1
+bool testInversion(){
+    vector<Modular<int>> identity(64, 0);
+    for(int i=0; i<8; i++) identity[9*i] = 1;
+    SBoxProfile p = analyzeSBox(makeSBox(rijndael_Mod, identity, 0));
+    return p.differentialUniformity == 4 && p.nonlinearity == 112 && p.algebraicDegree == 7 && p.fixedPoints == 2;
+}
+
+// The identity is linear: every difference is certain and nothing is nonlinear
+bool testIdentity(){
+    vector<uint32_t> sbox(64);
+    for(uint32_t x=0; x<64; x++) sbox[x] = x;
+    SBoxProfile p = analyzeSBox(sbox, 2);
+    return p.differentialUniformity == 64 && p.nonlinearity == 0 && p.algebraicDegree == 1 && p.fixedPoints == 64;
+}
+
+// Random 6 bit S-Boxes: the transform matches direct sums and thread counts agree
+bool testRandomTables(){
+    std::mt19937 rng(43);
+    bool ok = true;
+    vector<vector<uint32_t>> boxes;
+    for(int k=0; k<8; k++){
+        vector<uint32_t> sbox(64);
+        for(uint32_t x=0; x<64; x++) sbox[x] = rng() % 64;
+        ok &= linearTable(sbox, 3) == linearTableDirect(sbox);
+        ok &= differenceTable(sbox, 3) == differenceTable(sbox, 1);
+        boxes.push_back(sbox);
+    }
+    
+    vector<SBoxProfile> bulk = analyzeSBoxes(boxes, 3);
+    for(size_t k=0; k<boxes.size(); k++){
+        SBoxProfile p = analyzeSBox(boxes[k], 1);
+        ok &= bulk[k].differentialUniformity == p.differentialUniformity && bulk[k].linearity == p.linearity
+            && bulk[k].algebraicDegree == p.algebraicDegree && bulk[k].fixedPoints == p.fixedPoints;
+    }
+    return ok;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("AES S-Box profile", testAes());
+    ok &= report("Inversion without the affine map", testInversion());
+    ok &= report("Identity S-Box profile", testIdentity());
+    ok &= report("Fast tables match direct tables", testRandomTables());
+    
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+/*
+ * stream_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing the ECB, CBC and CTR streams against the NIST SP 800-38A
+ * examples, and streamed pieces of every mode, GCM included,
+ * against whole messages on every engine.
+ */
+
+#include "lib/cipher_stream.h"
+#include "lib/gcm.h"
+#include "test_util.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::string;
+using std::vector;
+
+// The SP 800-38A example key and four block plaintext
+const string exampleKey = "2b7e151628aed2a6abf7158809cf4f3c";
+const string examplePlaintext =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+
+// Engines to run every case on, hardware only where the processor has it
+vector<AesEngine> engines(){
+    vector<AesEngine> e = { ENGINE_TABLE };
+    if(resolveEngine(ENGINE_HARDWARE) == ENGINE_HARDWARE) e.push_back(ENGINE_HARDWARE);
+    return e;
+}
+
+// Feeds in through a stream in random pieces, returns everything it wrote
+vector<unsigned char> runStream(CipherStream & stream, const vector<unsigned char> & in, std::mt19937 & rng){
+    vector<unsigned char> out(in.size() + 16);
+    size_t done = 0, written = 0;
+    while(done < in.size()){
+        size_t piece = std::min((size_t) (rng() % 40), in.size() - done);
+        written += stream.update(in.data() + done, piece, out.data() + written);
+        done += piece;
+    }
+    written += stream.finalize(out.data() + written);
+    out.resize(written);
+    return out;
+}
+
+// Each mode encrypts the example to the published ciphertext and decrypts it back, in pieces
+bool testVectors(){
+    vector<unsigned char> k = fromHex(exampleKey), p = fromHex(examplePlaintext);
+    AesKey key(k.data(), 16);
+    CipherMode modes[3] = { MODE_ECB, MODE_CBC, MODE_CTR };
+    string ivs[3] = { "", "000102030405060708090a0b0c0d0e0f", "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff" };
+    string ciphertexts[3] = {
+        "3ad77bb40d7a3660a89ecaf32466ef97f5d3d58503b9699de785895a96fdbaaf"
+        "43b1cd7f598ece23881b00e3ed0306887b0c785e27e8ad3f8223207104725dd4",
+        "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+        "73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7",
+        "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+        "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee"
+    };
+    
+    std::mt19937 rng(49);
+    bool ok = true;
+    for(AesEngine engine : engines()){
+        for(int m=0; m<3; m++){
+            vector<unsigned char> iv = fromHex(ivs[m]), c = fromHex(ciphertexts[m]);
+            const unsigned char * ivData = iv.empty() ? nullptr : iv.data();
+            CipherStream encrypting(key, modes[m], true, ivData, engine);
+            CipherStream decrypting(key, modes[m], false, ivData, engine);
+            ok &= runStream(encrypting, p, rng) == c && runStream(decrypting, c, rng) == p;
+        }
+    }
+    return ok;
+}
+
+// Random lengths in random pieces round trip, and ECB and CBC pad like encrypt() in aes.h
+bool testPieces(){
+    std::mt19937 rng(50);
+    unsigned char k[16], iv[16];
+    for(int i=0; i<16; i++) k[i] = (unsigned char) rng();
+    for(int i=0; i<16; i++) iv[i] = (unsigned char) rng();
+    AesKey key(k, 16);
+    
+    bool ok = true;
+    CipherMode modes[3] = { MODE_ECB, MODE_CBC, MODE_CTR };
+    for(AesEngine engine : engines()){
+        for(int length=0; length<=300; length+=13){
+            vector<unsigned char> p(length);
+            for(int i=0; i<length; i++) p[i] = (unsigned char) rng();
+            
+            for(int m=0; m<3; m++){
+                CipherStream encrypting(key, modes[m], true, iv, engine);
+                CipherStream decrypting(key, modes[m], false, iv, engine);
+                vector<unsigned char> c = runStream(encrypting, p, rng), back = runStream(decrypting, c, rng);
+                
+                // ECB and CBC come back zero padded to whole blocks
+                vector<unsigned char> padded = p;
+                if(modes[m] != MODE_CTR) padded.resize((length + 15) / 16 * 16, 0);
+                ok &= back == padded && c.size() == padded.size();
+                
+                // ECB matches the block engine on the padded message
+                if(modes[m] == MODE_ECB){
+                    vector<unsigned char> whole(padded.size());
+                    encryptBlocks(engine, key, padded.data(), whole.data(), padded.size() / 16);
+                    ok &= whole == c;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+// Decrypting in place in whole blocks, and a CTR counter carrying out of its last byte
+bool testInPlace(){
+    std::mt19937 rng(51);
+    unsigned char k[16], iv[16];
+    for(int i=0; i<16; i++) k[i] = (unsigned char) rng();
+    for(int i=0; i<16; i++) iv[i] = 0xff;
+    AesKey key(k, 16);
+    
+    bool ok = true;
+    vector<unsigned char> p(16*21);
+    for(size_t i=0; i<p.size(); i++) p[i] = (unsigned char) rng();
+    CipherMode modes[3] = { MODE_ECB, MODE_CBC, MODE_CTR };
+    for(int m=0; m<3; m++){
+        vector<unsigned char> c(p.size()), buffer;
+        CipherStream encrypting(key, modes[m], true, iv);
+        encrypting.update(p.data(), p.size(), c.data());
+        
+        buffer = c;
+        CipherStream decrypting(key, modes[m], false, iv);
+        decrypting.update(buffer.data(), 16*5, buffer.data());
+        decrypting.update(buffer.data() + 16*5, buffer.size() - 16*5, buffer.data() + 16*5);
+        ok &= buffer == p && decrypting.buffered() == 0;
+    }
+    
+    // The counter after ff...ff is zero
+    unsigned char counters[32] = {0}, keystream[32], out[32], zero[32] = {0};
+    for(int i=0; i<16; i++) counters[i] = 0xff;
+    encryptBlocks(ENGINE_TABLE, key, counters, keystream, 2);
+    CipherStream ctr(key, MODE_CTR, true, iv);
+    ctr.update(zero, 32, out);
+    ok &= vector<unsigned char>(out, out + 32) == vector<unsigned char>(keystream, keystream + 32);
+    
+    // A partial last block of ciphertext is an error
+    CipherStream cbc(key, MODE_CBC, false, iv);
+    cbc.update(p.data(), 20, out);
+    try{
+        cbc.finalize(out);
+        ok = false;
+    }
+    catch(const runtime_error &){}
+    return ok;
+}
+
+// Streamed GCM with additional data in pieces gives the same ciphertext and tag as whole messages
+bool testGcm(){
+    std::mt19937 rng(52);
+    unsigned char k[16], iv[12];
+    for(int i=0; i<16; i++) k[i] = (unsigned char) rng();
+    for(int i=0; i<12; i++) iv[i] = (unsigned char) rng();
+    AesKey key(k, 16);
+    
+    bool ok = true;
+    for(AesEngine engine : engines()){
+        Gcm gcm(key, GHASH_AUTO, engine);
+        GcmStream encrypting(gcm, true, iv, 12), decrypting(gcm, false, iv, 12);
+        for(int length=0; length<=300; length+=11){
+            size_t aadLength = rng() % 40;
+            vector<unsigned char> p(length), a(aadLength), whole(length), c(length), back(length);
+            for(int i=0; i<length; i++) p[i] = (unsigned char) rng();
+            for(size_t i=0; i<aadLength; i++) a[i] = (unsigned char) rng();
+            unsigned char wholeTag[16], tag[16];
+            gcm.encrypt(iv, 12, a.data(), aadLength, p.data(), whole.data(), length, wholeTag);
+            
+            // Encrypt in place, a piece at a time
+            c = p;
+            encrypting.reset(iv, 12);
+            size_t split = aadLength ? rng() % aadLength : 0;
+            encrypting.updateAad(a.data(), split);
+            encrypting.updateAad(a.data() + split, aadLength - split);
+            for(size_t done=0; done<(size_t) length; ){
+                size_t piece = std::min((size_t) (rng() % 40), length - done);
+                encrypting.update(c.data() + done, piece, c.data() + done);
+                done += piece;
+            }
+            encrypting.finalize(tag);
+            ok &= c == whole && vector<unsigned char>(tag, tag + 16) == vector<unsigned char>(wholeTag, wholeTag + 16);
+            
+            decrypting.reset(iv, 12);
+            decrypting.updateAad(a.data(), aadLength);
+            for(size_t done=0; done<(size_t) length; ){
+                size_t piece = std::min((size_t) (rng() % 40), length - done);
+                decrypting.update(c.data() + done, piece, back.data() + done);
+                done += piece;
+            }
+            ok &= decrypting.verify(tag) && back == p;
+            
+            tag[3] ^= 1;
+            decrypting.reset(iv, 12);
+            decrypting.updateAad(a.data(), aadLength);
+            decrypting.update(c.data(), length, back.data());
+            ok &= !decrypting.verify(tag);
+        }
+    }
+    return ok;
+}
+
+// Once finalize or verify ends a message every call but reset throws, and reset gives the same tag again
+bool testGcmFinished(){
+    unsigned char k[16] = {0}, iv[12] = {0}, p[20] = {0}, c[20], tag[16], again[16];
+    AesKey key(k, 16);
+    Gcm gcm(key);
+    GcmStream encrypting(gcm, true, iv, 12), decrypting(gcm, false, iv, 12);
+    encrypting.update(p, 20, c);
+    encrypting.finalize(tag);
+    decrypting.update(c, 20, p);
+    bool ok = decrypting.verify(tag);
+    
+    GcmStream * streams[2] = { &encrypting, &decrypting };
+    for(GcmStream * stream : streams){
+        int thrown = 0;
+        try{ stream->finalize(again); } catch(const runtime_error &){ thrown++; }
+        try{ stream->verify(tag); } catch(const runtime_error &){ thrown++; }
+        try{ stream->update(p, 4, c); } catch(const runtime_error &){ thrown++; }
+        try{ stream->updateAad(p, 4); } catch(const runtime_error &){ thrown++; }
+        ok &= thrown == 4;
+    }
+    
+    encrypting.reset(iv, 12);
+    encrypting.update(p, 20, c);
+    encrypting.finalize(again);
+    return ok && vector<unsigned char>(tag, tag + 16) == vector<unsigned char>(again, again + 16);
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("SP 800-38A ECB, CBC and CTR examples", testVectors());
+    ok &= report("Streamed pieces round trip", testPieces());
+    ok &= report("In place decryption and counter carry", testInPlace());
+    ok &= report("Streamed GCM matches whole messages", testGcm());
+    ok &= report("Finished GCM streams need a reset", testGcmFinished());
+    
+    return ok ? 0 : 1;
+}
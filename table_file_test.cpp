@@ -0,0 +1,137 @@
+/*
+ * table_file_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing table files: tables and keys read back from the
+ * mapping match what was written, and damaged, truncated or
+ * foreign files are refused.
+ */
+
+#include "lib/table_file.h"
+#include "test_util.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::string;
+using std::vector;
+
+// Scratch file the tests write and damage
+const string path = "table_file_test.tmp";
+
+// Reads a whole file
+vector<unsigned char> readFile(const string & name){
+    vector<unsigned char> bytes;
+    FILE * f = fopen(name.c_str(), "rb");
+    if(f == nullptr) return bytes;
+    int c;
+    while((c = fgetc(f)) != EOF) bytes.push_back((unsigned char) c);
+    fclose(f);
+    return bytes;
+}
+
+// Replaces a whole file
+void writeFile(const string & name, const vector<unsigned char> & bytes){
+    FILE * f = fopen(name.c_str(), "wb");
+    fwrite(bytes.data(), 1, bytes.size(), f);
+    fclose(f);
+}
+
+// Returns true if opening the file throws
+bool refused(bool verify = true){
+    try{
+        TableFile file(path, verify);
+    }
+    catch(const runtime_error &){
+        return true;
+    }
+    return false;
+}
+
+// Writes the AES tables and some keys of every length, then reads them back
+bool testRoundTrip(){
+    std::mt19937 rng(41);
+    vector<AesKey> keys;
+    for(int i=0; i<9; i++){
+        unsigned char key[32];
+        for(int j=0; j<32; j++) key[j] = (unsigned char) rng();
+        keys.push_back(AesKey(key, 16 + 8*(i % 3)));
+    }
+    
+    TableFileWriter writer;
+    writer.addAesTables(aesTables());
+    writer.addKeys(keys.data(), keys.size());
+    writer.write(path);
+    
+    TableFile file(path);
+    bool ok = file.sectionCount() == 2 && file.aesTables() != nullptr && file.keyCount() == keys.size();
+    ok &= file.aesTables() != nullptr && memcmp(file.aesTables(), &aesTables(), sizeof(AesTables)) == 0;
+    for(size_t i=0; ok && i<keys.size(); i++){
+        unsigned char block[16], expected[16], mapped[16];
+        for(int j=0; j<16; j++) block[j] = (unsigned char) rng();
+        encryptBlocks(ENGINE_TABLE, keys[i], block, expected, 1);
+        encryptBlocks(ENGINE_TABLE, file.key(i), block, mapped, 1);
+        ok &= memcmp(expected, mapped, 16) == 0 && file.key(i).rounds() == keys[i].rounds();
+    }
+    return ok;
+}
+
+// A flipped bit in a section, the header or the directory, a short file or another version is refused
+bool testDamage(){
+    TableFileWriter writer;
+    writer.addAesTables(aesTables());
+    writer.write(path);
+    vector<unsigned char> good = readFile(path);
+    if(good.size() < 128 || refused()) return false;
+    
+    bool ok = true;
+    vector<unsigned char> bad = good;
+    bad[good.size() - 100] ^= 1;
+    writeFile(path, bad);
+    ok &= refused() && !refused(false);
+    
+    size_t damaged[3] = { 8, 24, 64 };
+    for(int i=0; i<3; i++){
+        bad = good;
+        bad[damaged[i]] ^= 0x10;
+        writeFile(path, bad);
+        ok &= refused(false);
+    }
+    
+    bad.assign(good.begin(), good.end() - 64);
+    writeFile(path, bad);
+    ok &= refused(false);
+    
+    bad.assign(good.begin(), good.begin() + 10);
+    writeFile(path, bad);
+    ok &= refused(false);
+    return ok;
+}
+
+// Tables cannot be swapped once an engine has used them
+bool testInstallAfterUse(){
+    aesTables();
+    try{
+        installAesTables(aesTables());
+    }
+    catch(const runtime_error &){
+        return true;
+    }
+    return false;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("Tables and keys read back from the mapping", testRoundTrip());
+    ok &= report("Damaged files are refused", testDamage());
+    ok &= report("Tables cannot be installed after use", testInstallAfterUse());
+    
+    std::remove(path.c_str());
+    return ok ? 0 : 1;
+}
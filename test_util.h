@@ -0,0 +1,26 @@
+/*
+ * test_util.h
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Helpers shared by the test programs: reporting a check as
+ * passed or FAILED. fromHex for test vectors comes from
+ * lib/byte_span.h.
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include "lib/byte_span.h"
+#include <iostream>
+#include <string>
+
+using std::string;
+
+// Reports a result and returns it
+inline bool report(const string & name, bool ok){
+    std::cout << (ok ? "passed: " : "FAILED: ") << name << "\n";
+    return ok;
+}
+
+#endif
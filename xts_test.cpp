@@ -0,0 +1,98 @@
+/*
+ * xts_test.cpp
+ * Author: Aven Bross
+ * Date: 10/18/2026
+ * 
+ * Testing XTS-AES against IEEE 1619 vectors, ciphertext
+ * stealing and threaded sector processing
+ */
+ 
+#include "lib/xts.h"
+#include "test_util.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::string;
+using std::vector;
+
+// Runs one vector on both engines, encrypting and decrypting in place
+bool testXtsVector(const string & key, uint64_t sector, const string & plaintext, const string & ciphertext){
+    vector<unsigned char> k = fromHex(key), p = fromHex(plaintext), c = fromHex(ciphertext);
+    
+    bool ok = true;
+    AesEngine engines[2] = { ENGINE_TABLE, ENGINE_HARDWARE };
+    for(int e=0; e<2; e++){
+        int half = k.size() / 2;
+        Xts xts(AesKey(k.data(), half), AesKey(k.data() + half, half), engines[e]);
+        vector<unsigned char> buffer = p;
+        xts.encryptSectors(buffer.data(), buffer.data(), buffer.size(), 1, sector, 1);
+        if(buffer != c) ok = false;
+        xts.decryptSectors(buffer.data(), buffer.data(), buffer.size(), 1, sector, 1);
+        if(buffer != p) ok = false;
+    }
+    return ok;
+}
+
+// The same key for data and tweak is refused, as with the all zero keys of IEEE 1619 vector 1
+bool testIdenticalKeys(){
+    unsigned char key[32] = {0};
+    try{
+        Xts xts(AesKey(key, 16), AesKey(key + 16, 16));
+        return false;
+    }
+    catch(const runtime_error &){}
+    
+    key[31] = 1;
+    Xts xts(AesKey(key, 16), AesKey(key + 16, 16));
+    return true;
+}
+
+// Many 4 KB sectors on several threads must match one sector at a time
+bool testXtsThreads(){
+    std::mt19937 rng(1619);
+    unsigned char key[32];
+    for(int i=0; i<32; i++) key[i] = (unsigned char) rng();
+    Xts xts(AesKey(key, 16), AesKey(key + 16, 16));
+    
+    const size_t sectorSize = 4096, sectors = 64;
+    vector<unsigned char> p(sectorSize*sectors), threaded(p.size()), serial(p.size());
+    for(size_t i=0; i<p.size(); i++) p[i] = (unsigned char) rng();
+    
+    xts.encryptSectors(p.data(), threaded.data(), sectorSize, sectors, 1000, 4);
+    for(size_t s=0; s<sectors; s++){
+        xts.encryptSectors(p.data() + s*sectorSize, serial.data() + s*sectorSize, sectorSize, 1, 1000 + s, 1);
+    }
+    if(threaded != serial) return false;
+    
+    xts.decryptSectors(threaded.data(), threaded.data(), sectorSize, sectors, 1000, 4);
+    return threaded == p;
+}
+
+int main(){
+    bool ok = true;
+    
+    ok &= report("Identical data and tweak keys are refused", testIdenticalKeys());
+    ok &= report("IEEE 1619 vector 2", testXtsVector(
+        "1111111111111111111111111111111122222222222222222222222222222222", 0x3333333333,
+        "4444444444444444444444444444444444444444444444444444444444444444",
+        "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0"));
+    ok &= report("XTS-AES-256, 48 bytes", testXtsVector(
+        "3f3e3d3c3b3a393837363534333231302f2e2d2c2b2a29282726252423222120"
+        "1f1e1d1c1b1a191817161514131211100f0e0d0c0b0a09080706050403020100", 0x123456789aull,
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f",
+        "31c75a87b750d56efc91f2d197219e98a35e2d2b4b04077b1e2eaa1820a3b1437790e3995ce1d8d17e145ee66c4d42be"));
+    ok &= report("Ciphertext stealing, 17 bytes", testXtsVector(
+        "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0", 0x9a78563412,
+        "000102030405060708090a0b0c0d0e0f10",
+        "641610679dcbf92e505c41333fb06c2a95"));
+    ok &= report("Ciphertext stealing, 34 bytes", testXtsVector(
+        "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0", 0x9a78563412,
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f2021",
+        "95c871f6522469cc737109594ab0feda28ffebb41ef3e34ffd5f393491ca76aa383a"));
+    ok &= report("Threaded sectors match serial sectors", testXtsThreads());
+    
+    return ok ? 0 : 1;
+}